@@ -1,22 +1,80 @@
 /** Need this include here for port to Android **/
 #include <SDL2/SDL.h>
 #include "game/Game.hpp"
+#include <cstring>
+#include <cstdlib>
 #include "util/Util.hpp"
+#include "util/AllocationTracker.hpp"
+#include "util/Trace.hpp"
+#include "util/Constants.hpp"
 
-void handleArgs(int, char **);
+unsigned int handleArgs(Game &game, int, char **);
 
 int main(int argc, char** argv) {
-    /** At this point we don't need the input args 
-     * So just print them out and let the user know **/
-    handleArgs(argc, argv);
     Game game;
-    game.run();
+    unsigned int headlessSteps = handleArgs(game, argc, argv);
+    if(headlessSteps > 0) game.runHeadless(headlessSteps);
+    else game.run();
     return 0;
 }
 
-void handleArgs(int argc, char **argv) {
-    if(argc > 1) {
-        Util::log("\nArguments will be ignored:\n");
-        for(int i = 1; i < argc; i++) { printf("%s ", argv[i]); }
+/** --record <file> saves the keyboard input of the session,
+ * --replay <file> plays a saved session back instead of the keyboard,
+ * --headless <steps> runs that many simulation steps as fast as possible without drawing and reports how long they took
+ * --log-allocations logs every frame that allocates, --no-steady-allocations quits when a steady state frame allocates
+ *   (both need a build that tracks allocations, make game-alloc)
+ * --log-render-stats logs what the window drew (copies, target switches...) over the last frames every few seconds
+ * --trace <file> saves a Chrome trace of the session when it ends or when F12 is pressed (needs make game-trace)
+ * --stress <npcs> fills the world with that many NPCs walking at random (at most one per free tile of the map)
+ *   and quits after reporting what they cost,
+ *   --stress-map <file> picks the map, --stress-seconds <s> how long it runs, --stress-report <file> where the CSV line goes
+ * Anything else is printed out and ignored
+ * Returns the number of headless steps, 0 to run normally **/
+unsigned int handleArgs(Game &game, int argc, char **argv) {
+    bool ignored = false;
+    unsigned int headlessSteps = 0;
+    unsigned int stressNpcs = 0, stressSeconds = Constants::STRESS_DEFAULT_SECONDS;
+    std::string stressMap, stressReport;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            headlessSteps = static_cast<unsigned int> (strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            game.recordInput(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            game.replayInput(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            if(!Trace::isAvailable()) Util::log("--trace needs a build with the trace scopes (make game-trace)");
+            game.traceTo(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+            stressNpcs = static_cast<unsigned int> (strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "--stress-map") == 0 && i + 1 < argc) {
+            stressMap = argv[++i];
+        }
+        else if(strcmp(argv[i], "--stress-seconds") == 0 && i + 1 < argc) {
+            stressSeconds = static_cast<unsigned int> (strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "--stress-report") == 0 && i + 1 < argc) {
+            stressReport = argv[++i];
+        }
+        else if(strcmp(argv[i], "--log-render-stats") == 0) {
+            game.logRenderStats();
+        }
+        else if(strcmp(argv[i], "--log-allocations") == 0 || strcmp(argv[i], "--no-steady-allocations") == 0) {
+            if(!AllocationTracker::isAvailable()) Util::log(std::string(argv[i]) + " needs a build that tracks allocations (make game-alloc)");
+            if(strcmp(argv[i], "--log-allocations") == 0) AllocationTracker::setLogFrames(true);
+            else AllocationTracker::setAssertSteadyState(true);
+        }
+        else {
+            if(!ignored) Util::log("\nArguments will be ignored:\n");
+            ignored = true;
+            printf("%s ", argv[i]);
+        }
     }
+    if(stressNpcs > 0) game.stressTest(stressNpcs, stressMap, stressSeconds, stressReport);
+    return headlessSteps;
 }
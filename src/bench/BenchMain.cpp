@@ -0,0 +1,17 @@
+/** Need this include here for port to Android **/
+#include <SDL2/SDL.h>
+#include "../game/Game.hpp"
+#include "BenchmarkSuite.hpp"
+#include "Benchmarks.hpp"
+
+/** Runs every benchmark headless and writes the results to the file given (bench.json by default) **/
+int main(int argc, char** argv) {
+    const char *path = argc > 1 ? argv[1] : "bench.json";
+    Game game;
+    game.runHeadless([path](Game *headlessGame) {
+        BenchmarkSuite suite;
+        Benchmarks::runAll(headlessGame, suite);
+        suite.writeJson(path);
+    });
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "BenchmarkSuite.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <algorithm>
+#include <SDL2/SDL.h>
+#include "../util/Constants.hpp"
+#include "../util/Util.hpp"
+
+typedef std::chrono::steady_clock Clock;
+
+BenchmarkSuite::BenchmarkSuite() {}
+
+long long BenchmarkSuite::timeSample(const std::function<void(unsigned long long)> &benchmark, unsigned long long iterations) {
+	Clock::time_point start = Clock::now();
+	benchmark(iterations);
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+void BenchmarkSuite::run(const std::string &name, const std::function<void(unsigned long long)> &benchmark) {
+	//Warm up (caches, lazily loaded things) and find out how many iterations make a sample long enough
+	long long minSampleNs = Constants::BENCH_MIN_SAMPLE_TIME * 1000LL;
+	unsigned long long iterations = 1;
+	while (timeSample(benchmark, iterations) < minSampleNs && iterations < (1ULL << 40)) iterations *= 2;
+
+	std::vector<double> perIteration(Constants::BENCH_SAMPLES);
+	for (unsigned int i = 0; i < perIteration.size(); i++) {
+		perIteration[i] = static_cast<double> (timeSample(benchmark, iterations)) / iterations;
+	}
+	std::sort(perIteration.begin(), perIteration.end());
+
+	BenchmarkResult result;
+	result.name = name;
+	result.iterations = iterations;
+	result.samples = perIteration.size();
+	result.minNs = perIteration.front();
+	result.maxNs = perIteration.back();
+	double sum = 0;
+	for (unsigned int i = 0; i < perIteration.size(); i++) sum += perIteration[i];
+	result.meanNs = sum / perIteration.size();
+	unsigned int middle = perIteration.size() / 2;
+	result.medianNs = perIteration.size() % 2 == 1 ? perIteration[middle] : (perIteration[middle - 1] + perIteration[middle]) / 2;
+	result.p90Ns = perIteration[std::min<size_t>(perIteration.size() - 1, perIteration.size() * 9 / 10)];
+	double squares = 0;
+	for (unsigned int i = 0; i < perIteration.size(); i++) {
+		squares += (perIteration[i] - result.meanNs) * (perIteration[i] - result.meanNs);
+	}
+	result.stddevNs = perIteration.size() > 1 ? sqrt(squares / (perIteration.size() - 1)) : 0;
+	results.push_back(result);
+
+	char line[256];
+	snprintf(line, sizeof(line), "%-56s median %12.1f ns  mean %12.1f ns  p90 %12.1f ns  (+/- %.1f, %llu x %u)",
+		name.c_str(), result.medianNs, result.meanNs, result.p90Ns, result.stddevNs, result.iterations, result.samples);
+	Util::log(SDL_LOG_PRIORITY_INFO, line);
+}
+
+const std::vector<BenchmarkResult> & BenchmarkSuite::getResults() const {
+	return results;
+}
+
+static void appendString(std::string &json, const std::string &text) {
+	json += '"';
+	for (unsigned int i = 0; i < text.size(); i++) {
+		if (text[i] == '"' || text[i] == '\\') json += '\\';
+		json += text[i];
+	}
+	json += '"';
+}
+
+bool BenchmarkSuite::writeJson(const char *path) const {
+	std::string json = "{\"unit\":\"ns\",\"benchmarks\":[";
+	char numbers[320];
+	for (unsigned int i = 0; i < results.size(); i++) {
+		const BenchmarkResult &result = results[i];
+		if (i > 0) json += ',';
+		json += "\n{\"name\":";
+		appendString(json, result.name);
+		snprintf(numbers, sizeof(numbers), ",\"iterations\":%llu,\"samples\":%u,\"min\":%.3f,\"max\":%.3f,\"mean\":%.3f,"
+			"\"median\":%.3f,\"p90\":%.3f,\"stddev\":%.3f}",
+			result.iterations, result.samples, result.minNs, result.maxNs, result.meanNs, result.medianNs, result.p90Ns, result.stddevNs);
+		json += numbers;
+	}
+	json += "\n]}\n";
+
+	SDL_RWops *file = SDL_RWFromFile(path, "wb");
+	if (file == NULL) {
+		Util::log(SDL_LOG_PRIORITY_ERROR, std::string("Failed to open the benchmark results file ") + path);
+		return false;
+	}
+	bool saved = SDL_RWwrite(file, json.data(), 1, json.size()) == json.size();
+	SDL_RWclose(file);
+	Util::log(SDL_LOG_PRIORITY_INFO, "Wrote " + std::to_string(results.size()) + " benchmark results to " + path);
+	return saved;
+}
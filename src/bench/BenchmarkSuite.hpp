@@ -0,0 +1,44 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+/**
+ * Times benchmarks and writes what it found out as JSON
+ * A benchmark does its work as many times as it is told to, the suite keeps doubling that until
+ * a sample takes at least Constants::BENCH_MIN_SAMPLE_TIME, then times Constants::BENCH_SAMPLES samples
+ * Every result is in nanoseconds per iteration
+ */
+
+#include <string>
+#include <vector>
+#include <functional>
+
+typedef struct BenchmarkResult {
+	std::string name;
+	unsigned long long iterations;
+	unsigned int samples;
+	double minNs, maxNs, meanNs, medianNs, p90Ns, stddevNs;
+} BenchmarkResult;
+
+class BenchmarkSuite {
+public:
+	BenchmarkSuite();
+
+	//Run a benchmark, benchmark(iterations) does the work that many times
+	void run(const std::string &name, const std::function<void(unsigned long long)> &benchmark);
+
+	const std::vector<BenchmarkResult> & getResults() const;
+
+	//Returns false if the file can't be written
+	bool writeJson(const char *path) const;
+
+	//Keep the compiler from throwing away work whose result nothing reads
+	template <typename T>
+	static void doNotOptimize(const T &value) { asm volatile("" : : "r"(&value) : "memory"); }
+
+private:
+	std::vector<BenchmarkResult> results;
+
+	static long long timeSample(const std::function<void(unsigned long long)> &benchmark, unsigned long long iterations);
+};
+
+#endif
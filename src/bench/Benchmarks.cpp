@@ -0,0 +1,224 @@
+#include "Benchmarks.hpp"
+#include "BenchmarkSuite.hpp"
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include "../game/Game.hpp"
+#include "../game/Window.hpp"
+#include "../screen/WorldScreen.hpp"
+#include "../world/World.hpp"
+#include "../world/WorldCharacter.hpp"
+#include "../map/Map.hpp"
+#include "../map/MapLoader.hpp"
+#include "../util/XMLParser.hpp"
+#include "../util/FileUtil.hpp"
+#include "../util/Arena.hpp"
+#include "../util/Constants.hpp"
+#include "../util/Util.hpp"
+#include "../util/TimerWheel.hpp"
+#include "../util/AllocationTracker.hpp"
+
+void Benchmarks::runAll(Game *game, BenchmarkSuite &suite) {
+	benchLoadXML(suite);
+	benchParseLayer(suite);
+	benchFindFiles(suite);
+	benchTimerWheel(suite);
+
+	WorldScreen *screen = static_cast<WorldScreen *> (game->getCurrentScreen());
+	if (screen == NULL || screen->getWorld()->getMap() == NULL) {
+		Util::log(SDL_LOG_PRIORITY_ERROR, "No world to benchmark, skipping the map benchmarks");
+		return;
+	}
+	World *world = screen->getWorld();
+	benchGetTile(suite, world);
+	benchObstacles(suite, world);
+
+	//The world has to have published (and the main thread acquired) a snapshot before it can be drawn
+	screen->publishSnapshot(game);
+	screen->acquireSnapshot();
+	benchDrawMap(suite, game, world);
+}
+
+static std::vector<std::string> getXMLFiles() {
+	std::vector<std::string> files = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::TILESET_FILE_EXTENSION);
+	std::vector<std::string> maps = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::MAP_FILE_EXTENSION);
+	files.insert(files.end(), maps.begin(), maps.end());
+	return files;
+}
+
+/**
+ * Every file parsed the way the map loader parses it, into an arena that is reset for the next one
+ */
+void Benchmarks::benchLoadXML(BenchmarkSuite &suite) {
+	std::vector<std::string> files = getXMLFiles();
+	Arena arena(Constants::MAP_LOAD_ARENA_SIZE);
+	for (unsigned int i = 0; i < files.size(); i++) {
+		const std::string &path = files[i];
+		suite.run("XMLParser::loadXML/" + FileUtil::getFileName(path.c_str()), [&path, &arena](unsigned long long iterations) {
+			for (unsigned long long n = 0; n < iterations; n++) {
+				arena.reset();
+				XMLObject *obj = XMLParser::loadXML(path.c_str(), &arena);
+				BenchmarkSuite::doNotOptimize(obj);
+			}
+		});
+	}
+}
+
+/**
+ * Every layer of a map read from its CSV tile data, the way MapLoader fills a map's layers
+ */
+void Benchmarks::benchParseLayer(BenchmarkSuite &suite) {
+	typedef struct Layer {
+		const XMLString *data;
+		int width, height;
+	} Layer;
+
+	std::vector<std::string> maps = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::MAP_FILE_EXTENSION);
+	Arena arena(Constants::MAP_LOAD_ARENA_SIZE);
+	for (unsigned int i = 0; i < maps.size(); i++) {
+		arena.reset();
+		XMLObject *obj = XMLParser::loadXML(maps[i].c_str(), &arena);
+		if (obj == NULL || obj->tags.empty()) continue;
+
+		std::vector<Layer> layers;
+		for (unsigned int j = 0; j < obj->tags[0]->subTags.size(); j++) {
+			Tag *tag = obj->tags[0]->subTags[j];
+			if (tag->id != "layer" || tag->subTags.empty() || tag->subTags[0]->id != "data") continue;
+			Layer layer = { &tag->subTags[0]->data, 0, 0 };
+			for (unsigned int k = 0; k < tag->attributes.size(); k++) {
+				if (tag->attributes[k].first == "width") layer.width = atoi(tag->attributes[k].second.c_str());
+				else if (tag->attributes[k].first == "height") layer.height = atoi(tag->attributes[k].second.c_str());
+			}
+			if (layer.width > 0 && layer.height > 0) layers.push_back(layer);
+		}
+		if (layers.empty()) continue;
+
+		//One grid big enough for the biggest layer, indexed [tileX][tileY] like a map's layers
+		int width = 0, height = 0;
+		for (unsigned int j = 0; j < layers.size(); j++) {
+			if (layers[j].width > width) width = layers[j].width;
+			if (layers[j].height > height) height = layers[j].height;
+		}
+		std::vector<int> tiles(width * height, 0);
+		std::vector<int *> columns(width);
+		for (int x = 0; x < width; x++) columns[x] = &tiles[x * height];
+
+		suite.run("MapLoader::parseLayer/" + FileUtil::getFileName(maps[i].c_str()), [&layers, &columns, &tiles](unsigned long long iterations) {
+			for (unsigned long long n = 0; n < iterations; n++) {
+				for (unsigned int j = 0; j < layers.size(); j++) {
+					MapLoader::parseLayer(layers[j].data->c_str(), layers[j].data->size(), &columns[0], layers[j].width, layers[j].height);
+				}
+				BenchmarkSuite::doNotOptimize(tiles[0]);
+			}
+		});
+	}
+}
+
+void Benchmarks::benchFindFiles(BenchmarkSuite &suite) {
+	suite.run(std::string("FileUtil::getFilesRecursively/") + Constants::IMAGE_FILE_EXTENSION, [](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) {
+			std::vector<std::string> files = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::IMAGE_FILE_EXTENSION);
+			BenchmarkSuite::doNotOptimize(files);
+		}
+	});
+}
+
+//A timer that schedules itself again every time it goes off, like a game object's tick
+typedef struct RearmingTimer {
+	TimerWheel *wheel;
+	unsigned int delayUs;
+
+	void arm() { wheel->schedule(delayUs, [this]() { arm(); }); }
+} RearmingTimer;
+
+/**
+ * Advancing the wheel with timers re-arming at the rates of the world's objects, one iteration is one step
+ * In a build that tracks allocations (make bench-alloc) it also checks that the steady state doesn't allocate
+ */
+void Benchmarks::benchTimerWheel(BenchmarkSuite &suite) {
+	TimerWheel wheel(Constants::GAME_TICK_MICROSECONDS);
+	unsigned int walkUs = (unsigned int)Constants::CHARACTER_WALK_TIMER * 1000;
+	RearmingTimer timers[] = {
+		{ &wheel, walkUs },
+		{ &wheel, walkUs },
+		{ &wheel, Constants::GAME_TICK_MICROSECONDS },
+		{ &wheel, 5000000 }
+	};
+	for (unsigned int i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) timers[i].arm();
+	suite.run("TimerWheel::advance/re-arming", [&wheel](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) wheel.advance();
+		BenchmarkSuite::doNotOptimize(wheel);
+	});
+	if (!AllocationTracker::isAvailable()) return;
+
+	//Warmed up by the benchmark, every slot has had its turn, another second of steps shouldn't allocate at all
+	AllocationTracker::endFrame(false);
+	for (unsigned int i = 0; i < Constants::TARGET_TICKS_PER_SECOND; i++) wheel.advance();
+	AllocationTracker::endFrame(false);
+	unsigned long long allocations = AllocationTracker::getLastFrame().getTotalAllocations();
+	if (allocations > 0) {
+		Util::log(SDL_LOG_PRIORITY_ERROR, "TimerWheel::advance allocated " + std::to_string(allocations) 
+			+ " times re-arming timers in the steady state");
+	}
+	else {
+		Util::log(SDL_LOG_PRIORITY_INFO, "TimerWheel::advance doesn't allocate re-arming timers in the steady state");
+	}
+}
+
+/**
+ * Every tile of every layer of the map the world starts on, one iteration is the whole map
+ */
+void Benchmarks::benchGetTile(BenchmarkSuite &suite, World *world) {
+	Map *map = world->getMap();
+	suite.run("Map::getTile/" + map->getMapName(), [map](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) {
+			for (unsigned int layer = 0; layer < map->getNumberOfLayers(); layer++) {
+				for (int x = 0; x < map->getWidth(); x++) {
+					for (int y = 0; y < map->getHeight(); y++) {
+						Tile *tile = map->getTile(layer, x, y);
+						BenchmarkSuite::doNotOptimize(tile);
+					}
+				}
+			}
+		}
+	});
+}
+
+/**
+ * The player checking every tile of the map for something in the way, one iteration is the whole map
+ */
+void Benchmarks::benchObstacles(BenchmarkSuite &suite, World *world) {
+	Map *map = world->getMap();
+	WorldCharacter *player = static_cast<WorldCharacter *> (world->getPlayer());
+	suite.run("WorldCharacter::checkForObstacles/" + map->getMapName(), [map, player](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) {
+			int blocked = 0;
+			for (int x = 0; x < map->getWidth(); x++) {
+				for (int y = 0; y < map->getHeight(); y++) {
+					if (player->checkForObstacles(x, y)) blocked++;
+				}
+			}
+			BenchmarkSuite::doNotOptimize(blocked);
+		}
+	});
+}
+
+/**
+ * The world drawn with the software renderer the headless window uses
+ * Standing still the scroll buffers are reused, a changed tile makes them draw every tile again
+ */
+void Benchmarks::benchDrawMap(BenchmarkSuite &suite, Game *game, World *world) {
+	Window *win = game->getWindow();
+	win->setInterpolation(1.0f);
+	suite.run("World::drawMap/still", [win, world](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) world->render(win);
+	});
+
+	GameEvent tileChanged = { GAME_EVENT_TILE_CHANGED, 0, 0, 0, NULL };
+	suite.run("World::drawMap/tile changed", [win, world, &tileChanged](unsigned long long iterations) {
+		for (unsigned long long n = 0; n < iterations; n++) {
+			world->handleEvent(tileChanged);
+			world->render(win);
+		}
+	});
+}
@@ -0,0 +1,29 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+/**
+ * The game's hot paths, timed on the real files in res
+ * Runs headless, the world (and the map it starts on) is the one the game starts with
+ */
+
+class Game;
+class World;
+class BenchmarkSuite;
+
+class Benchmarks {
+public:
+	static void runAll(Game *game, BenchmarkSuite &suite);
+
+private:
+	static void benchLoadXML(BenchmarkSuite &suite);
+	static void benchParseLayer(BenchmarkSuite &suite);
+	static void benchFindFiles(BenchmarkSuite &suite);
+	static void benchTimerWheel(BenchmarkSuite &suite);
+	static void benchGetTile(BenchmarkSuite &suite, World *world);
+	static void benchObstacles(BenchmarkSuite &suite, World *world);
+	static void benchDrawMap(BenchmarkSuite &suite, Game *game, World *world);
+	Benchmarks();
+	~Benchmarks();
+};
+
+#endif
@@ -0,0 +1,26 @@
+#include "AnimationSystem.hpp"
+
+#include "EntityRegistry.hpp"
+
+void AnimationSystem::update(EntityRegistry &registry, const std::vector<Entity> &entities, int tileWidth, int tileHeight) {
+	const AnimatorPool &animators = registry.animators;
+	const MoverPool &movers = registry.movers;
+	SpriteRefPool &sprites = registry.sprites;
+	for (unsigned int e = 0; e < entities.size(); e++) {
+		Entity entity = entities[e];
+		unsigned int i = animators.indexOf(entity);
+		unsigned int sprite = sprites.indexOf(entity);
+		if (i == ComponentPool::NO_COMPONENT || sprite == ComponentPool::NO_COMPONENT) continue;
+		unsigned int mover = movers.indexOf(entity);
+		int row = DOWN, column = 0;
+		if (mover != ComponentPool::NO_COMPONENT) {
+			row = movers.facing[mover];
+			int tileSize = movers.direction[mover] == LEFT || movers.direction[mover] == RIGHT ? tileWidth : tileHeight;
+			if (movers.moving[mover] && movers.displacement[mover] * 2 >= tileSize) {
+				column = movers.walkLeft[mover] ? 1 : 3;
+			}
+		}
+		sprites.srcX[sprite] = column * animators.frameWidth[i];
+		sprites.srcY[sprite] = row * animators.frameHeight[i];
+	}
+}
@@ -0,0 +1,19 @@
+#ifndef ANIMATION_SYSTEM_HPP
+#define ANIMATION_SYSTEM_HPP
+
+#include <vector>
+#include "Entity.hpp"
+
+class EntityRegistry;
+
+/**
+ * Picks the sprite frame of animated entities, the same way the player's walk cycle works:
+ * the row is the facing direction, the walking frame shows for the second half of each tile
+ * Only the entities given (the awake ones) can have changed frame
+ */
+class AnimationSystem {
+public:
+	static void update(EntityRegistry &registry, const std::vector<Entity> &entities, int tileWidth, int tileHeight);
+};
+
+#endif
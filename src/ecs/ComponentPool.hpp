@@ -0,0 +1,77 @@
+#ifndef COMPONENT_POOL_HPP
+#define COMPONENT_POOL_HPP
+
+/**
+ * Sparse set of the entities that have a component
+ * The component data itself lives in the pool's columns (one vector per field, all indexed the same),
+ * so a system looping over one field only pulls that field into the cache
+ * Entities are packed at the front, removing one moves the last one into its place
+ */
+
+#include <vector>
+#include "Entity.hpp"
+
+class ComponentPool {
+public:
+	static const unsigned int NO_COMPONENT = 0xFFFFFFFF;
+
+	ComponentPool() {}
+	virtual ~ComponentPool() {}
+
+	bool has(const Entity &entity) const { return indexOf(entity) != NO_COMPONENT; }
+
+	//Index of the entity in the columns, NO_COMPONENT if it doesn't have the component
+	unsigned int indexOf(const Entity &entity) const {
+		if (entity.index >= sparse.size()) return NO_COMPONENT;
+		unsigned int dense = sparse[entity.index];
+		return dense != NO_COMPONENT && entities[dense] == entity ? dense : NO_COMPONENT;
+	}
+
+	unsigned int size() const { return static_cast<unsigned int> (entities.size()); }
+	Entity getEntity(unsigned int dense) const { return entities[dense]; }
+
+	//Take the component away from the entity, returns false if it didn't have it
+	bool remove(const Entity &entity) {
+		unsigned int dense = indexOf(entity);
+		if (dense == NO_COMPONENT) return false;
+		unsigned int last = size() - 1;
+		removeColumns(dense);
+		sparse[entities[last].index] = dense;
+		entities[dense] = entities[last];
+		entities.pop_back();
+		sparse[entity.index] = NO_COMPONENT;
+		return true;
+	}
+
+	void clear() {
+		while (!entities.empty()) {
+			Entity last = entities.back();
+			remove(last);
+		}
+	}
+
+protected:
+	//Start the entity's row, the pool pushes the values of every column after this
+	unsigned int addEntity(const Entity &entity) {
+		const unsigned int none = NO_COMPONENT;
+		if (entity.index >= sparse.size()) sparse.resize(entity.index + 1, none);
+		sparse[entity.index] = size();
+		entities.push_back(entity);
+		return sparse[entity.index];
+	}
+
+	//Remove row dense from every column by moving the last row into it
+	virtual void removeColumns(unsigned int dense) = 0;
+
+	template <typename T>
+	static void removeRow(std::vector<T> &column, unsigned int dense) {
+		column[dense] = column.back();
+		column.pop_back();
+	}
+
+private:
+	std::vector<Entity> entities;
+	std::vector<unsigned int> sparse;
+};
+
+#endif
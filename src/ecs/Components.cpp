@@ -0,0 +1,106 @@
+#include "Components.hpp"
+
+#include "../sprite/SpriteSheet.hpp"
+
+unsigned int TransformPool::add(const Entity &entity, int x, int y, int tileWidth, int tileHeight, int entityLayer) {
+	unsigned int dense = addEntity(entity);
+	tileX.push_back(x);
+	tileY.push_back(y);
+	posX.push_back(x * tileWidth);
+	posY.push_back(y * tileHeight);
+	previousPosX.push_back(x * tileWidth);
+	previousPosY.push_back(y * tileHeight);
+	drawX.push_back(x * tileWidth);
+	drawY.push_back(y * tileHeight);
+	layer.push_back(entityLayer);
+	awake.push_back(false);
+	return dense;
+}
+
+void TransformPool::removeColumns(unsigned int dense) {
+	removeRow(tileX, dense);
+	removeRow(tileY, dense);
+	removeRow(posX, dense);
+	removeRow(posY, dense);
+	removeRow(previousPosX, dense);
+	removeRow(previousPosY, dense);
+	removeRow(drawX, dense);
+	removeRow(drawY, dense);
+	removeRow(layer, dense);
+	removeRow(awake, dense);
+}
+
+unsigned int MoverPool::add(const Entity &entity, unsigned int tickTimeMs, int moveSpeed, FacingDirection facingDirection) {
+	unsigned int dense = addEntity(entity);
+	direction.push_back(NONE);
+	nextDirection.push_back(NONE);
+	facing.push_back(facingDirection);
+	moving.push_back(false);
+	blocked.push_back(false);
+	walkLeft.push_back(true);
+	displacement.push_back(0);
+	speed.push_back(moveSpeed);
+	tickTimeUs.push_back((tickTimeMs > 0 ? tickTimeMs : 1) * 1000);
+	sinceTickUs.push_back(0);
+	return dense;
+}
+
+void MoverPool::removeColumns(unsigned int dense) {
+	removeRow(direction, dense);
+	removeRow(nextDirection, dense);
+	removeRow(facing, dense);
+	removeRow(moving, dense);
+	removeRow(blocked, dense);
+	removeRow(walkLeft, dense);
+	removeRow(displacement, dense);
+	removeRow(speed, dense);
+	removeRow(tickTimeUs, dense);
+	removeRow(sinceTickUs, dense);
+}
+
+unsigned int SpriteRefPool::add(const Entity &entity, const ResourceHandle<SpriteSheet> &image, int w, int h, int drawOffsetY) {
+	unsigned int dense = addEntity(entity);
+	sheet.push_back(image);
+	texture.push_back(image.isReady() ? image->getTexture() : NULL);
+	srcX.push_back(0);
+	srcY.push_back(0);
+	width.push_back(w);
+	height.push_back(h);
+	offsetY.push_back(drawOffsetY);
+
+	//Nothing to draw until it is captured
+	SpriteState nothing = {};
+	state.push_back(nothing);
+	return dense;
+}
+
+void SpriteRefPool::removeColumns(unsigned int dense) {
+	removeRow(sheet, dense);
+	removeRow(texture, dense);
+	removeRow(srcX, dense);
+	removeRow(srcY, dense);
+	removeRow(width, dense);
+	removeRow(height, dense);
+	removeRow(offsetY, dense);
+	removeRow(state, dense);
+}
+
+unsigned int ColliderPool::add(const Entity &entity) {
+	unsigned int dense = addEntity(entity);
+	reservedTile.push_back(-1);
+	return dense;
+}
+
+void ColliderPool::removeColumns(unsigned int dense) { removeRow(reservedTile, dense); }
+
+unsigned int AnimatorPool::add(const Entity &entity, int width, int height) {
+	unsigned int dense = addEntity(entity);
+	frameWidth.push_back(width);
+	frameHeight.push_back(height);
+	return dense;
+}
+
+void AnimatorPool::removeColumns(unsigned int dense) {
+	removeRow(frameWidth, dense);
+	removeRow(frameHeight, dense);
+}
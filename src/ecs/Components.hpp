@@ -0,0 +1,93 @@
+#ifndef COMPONENTS_HPP
+#define COMPONENTS_HPP
+
+/**
+ * Component pools for world entities
+ * Every field is its own column, row i of every column in a pool belongs to getEntity(i)
+ * Systems read and write the columns directly
+ */
+
+#include <stdint.h>
+#include <SDL2/SDL_rect.h>
+#include "ComponentPool.hpp"
+#include "../util/ResourceHandle.hpp"
+#include "../world/FacingDirection.hpp"
+
+struct SDL_Texture;
+class SpriteSheet;
+
+//An entity sprite as of one simulation step, where it was drawn after the step before and after this one
+typedef struct SpriteState {
+	SDL_Texture *texture;
+	SDL_Rect src;
+	int previousX, previousY, x, y;
+	int layer;
+} SpriteState;
+
+//Where the entity is, in tiles and in pixels, where it was before its last movement step
+//and where it was drawn as of the last simulation step
+//Awake entities are the ones the systems look at every step, see MovementSystem::wake
+class TransformPool : public ComponentPool {
+public:
+	unsigned int add(const Entity &entity, int tileX, int tileY, int tileWidth, int tileHeight, int layer);
+
+	std::vector<int> tileX, tileY, posX, posY, previousPosX, previousPosY, drawX, drawY, layer;
+	std::vector<uint8_t> awake;
+
+protected:
+	void removeColumns(unsigned int dense) override;
+};
+
+//Walks from tile to tile, moving speed pixels every tickTime of simulated time
+class MoverPool : public ComponentPool {
+public:
+	unsigned int add(const Entity &entity, unsigned int tickTimeMs, int speed, FacingDirection facing);
+
+	std::vector<uint8_t> direction, nextDirection, facing, moving, blocked, walkLeft;
+	std::vector<int> displacement, speed;
+	std::vector<unsigned int> tickTimeUs, sinceTickUs;
+
+protected:
+	void removeColumns(unsigned int dense) override;
+};
+
+//The part of a sprite sheet to draw and how big, drawn centered on the entity's tile
+//state is what the sprite looked like when it was last captured, it only changes while the entity is awake
+class SpriteRefPool : public ComponentPool {
+public:
+	unsigned int add(const Entity &entity, const ResourceHandle<SpriteSheet> &sheet, int width, int height, int offsetY);
+
+	//The handle keeps the sheet loaded while the entity is around, the systems only look at the texture
+	std::vector<ResourceHandle<SpriteSheet> > sheet;
+	std::vector<SDL_Texture *> texture;
+	std::vector<int> srcX, srcY, width, height, offsetY;
+	std::vector<SpriteState> state;
+
+protected:
+	void removeColumns(unsigned int dense) override;
+};
+
+//Takes up its tile, nothing else with a collider can walk onto it
+class ColliderPool : public ComponentPool {
+public:
+	unsigned int add(const Entity &entity);
+
+	//Tile that is held for the entity while it walks onto it, -1 while standing still
+	std::vector<int> reservedTile;
+
+protected:
+	void removeColumns(unsigned int dense) override;
+};
+
+//Picks the sprite frame from the facing direction (row) and the walk cycle (column)
+class AnimatorPool : public ComponentPool {
+public:
+	unsigned int add(const Entity &entity, int frameWidth, int frameHeight);
+
+	std::vector<int> frameWidth, frameHeight;
+
+protected:
+	void removeColumns(unsigned int dense) override;
+};
+
+#endif
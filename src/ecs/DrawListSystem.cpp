@@ -0,0 +1,88 @@
+#include "DrawListSystem.hpp"
+
+#include <algorithm>
+#include "EntityRegistry.hpp"
+#include "../game/Window.hpp"
+
+static int interpolate(int previous, int current, float progress) {
+	return previous + static_cast<int> ((current - previous) * progress + (current >= previous ? 0.5f : -0.5f));
+}
+
+static bool drawsBefore(const DrawCommand &a, const DrawCommand &b) {
+	if (a.layer != b.layer) return a.layer < b.layer;
+	return a.dst.y + a.dst.h < b.dst.y + b.dst.h;
+}
+
+DrawListSystem::DrawListSystem() {}
+
+DrawListSystem::~DrawListSystem() {}
+
+bool DrawListSystem::capture(EntityRegistry &registry, const std::vector<Entity> &entities, int tileWidth, int tileHeight) {
+	bool moved = false;
+	SpriteRefPool &refs = registry.sprites;
+	TransformPool &transforms = registry.transforms;
+	const MoverPool &movers = registry.movers;
+	for (unsigned int e = 0; e < entities.size(); e++) {
+		Entity entity = entities[e];
+		unsigned int i = refs.indexOf(entity);
+		unsigned int transform = transforms.indexOf(entity);
+		if (i == ComponentPool::NO_COMPONENT || transform == ComponentPool::NO_COMPONENT) continue;
+
+		//Between the previous and current movement step, like the player
+		float progress = 1.0f;
+		unsigned int mover = movers.indexOf(entity);
+		if (mover != ComponentPool::NO_COMPONENT) {
+			progress = static_cast<float> (movers.sinceTickUs[mover]) / movers.tickTimeUs[mover];
+			if (progress > 1.0f) progress = 1.0f;
+		}
+		int x = interpolate(transforms.previousPosX[transform], transforms.posX[transform], progress);
+		int y = interpolate(transforms.previousPosY[transform], transforms.posY[transform], progress);
+
+		//Centered on the tile, at the bottom of it
+		int offsetX = tileWidth / 2 - refs.width[i] / 2;
+		int offsetY = tileHeight / 2 - refs.height[i] / 2 + refs.offsetY[i];
+		SpriteState &sprite = refs.state[i];
+		sprite.texture = refs.texture[i];
+		sprite.src.x = refs.srcX[i];
+		sprite.src.y = refs.srcY[i];
+		sprite.src.w = refs.width[i];
+		sprite.src.h = refs.height[i];
+		sprite.previousX = transforms.drawX[transform] + offsetX;
+		sprite.previousY = transforms.drawY[transform] + offsetY;
+		sprite.x = x + offsetX;
+		sprite.y = y + offsetY;
+		sprite.layer = transforms.layer[transform];
+
+		if (x != transforms.drawX[transform] || y != transforms.drawY[transform]) moved = true;
+		transforms.drawX[transform] = x;
+		transforms.drawY[transform] = y;
+	}
+	return moved;
+}
+
+void DrawListSystem::build(const std::vector<SpriteState> &sprites, const SDL_Rect &camera, float stepProgress) {
+	commands.clear();
+	for (unsigned int i = 0; i < sprites.size(); i++) {
+		const SpriteState &sprite = sprites[i];
+		DrawCommand command;
+		command.dst.w = sprite.src.w;
+		command.dst.h = sprite.src.h;
+		command.dst.x = interpolate(sprite.previousX, sprite.x, stepProgress);
+		command.dst.y = interpolate(sprite.previousY, sprite.y, stepProgress);
+		if (command.dst.x >= camera.x + camera.w || command.dst.x + command.dst.w <= camera.x
+			|| command.dst.y >= camera.y + camera.h || command.dst.y + command.dst.h <= camera.y) continue;
+		command.texture = sprite.texture;
+		command.src = sprite.src;
+		command.layer = sprite.layer;
+		commands.push_back(command);
+	}
+	std::sort(commands.begin(), commands.end(), drawsBefore);
+}
+
+void DrawListSystem::draw(Window *win) {
+	for (unsigned int i = 0; i < commands.size(); i++) {
+		win->drawTexture(commands[i].texture, &commands[i].src, &commands[i].dst);
+	}
+}
+
+unsigned int DrawListSystem::size() const { return static_cast<unsigned int> (commands.size()); }
@@ -0,0 +1,44 @@
+#ifndef DRAW_LIST_SYSTEM_HPP
+#define DRAW_LIST_SYSTEM_HPP
+
+#include <vector>
+#include <SDL2/SDL_rect.h>
+#include "Components.hpp"
+
+class EntityRegistry;
+class Window;
+struct SDL_Texture;
+
+typedef struct DrawCommand {
+	SDL_Texture *texture;
+	SDL_Rect src, dst;
+	int layer;
+} DrawCommand;
+
+/**
+ * Turns every entity sprite inside the camera into a draw command,
+ * sorted by layer then from the top of the map down so lower entities overlap higher ones
+ * The sprites of the entities that changed are captured on the simulation thread after every step
+ * (into SpriteRefPool::state), the commands are built from the newest copy of every state on the main thread
+ */
+class DrawListSystem {
+public:
+	DrawListSystem();
+	~DrawListSystem();
+
+	//Capture the sprites of the entities (the awake ones), returns true if any of them moved since their last capture
+	static bool capture(EntityRegistry &registry, const std::vector<Entity> &entities, int tileWidth, int tileHeight);
+
+	//stepProgress is how far the game is between the captured step and the next one
+	void build(const std::vector<SpriteState> &sprites, const SDL_Rect &camera, float stepProgress);
+
+	//Draw the commands from the last build, the window's camera has to be set
+	void draw(Window *win);
+
+	unsigned int size() const;
+
+private:
+	std::vector<DrawCommand> commands;
+};
+
+#endif
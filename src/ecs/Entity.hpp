@@ -0,0 +1,12 @@
+#ifndef ENTITY_HPP
+#define ENTITY_HPP
+
+#include "../util/SlotMap.hpp"
+
+//An entity is only an id, everything about it is stored in component pools
+//The generation makes ids of destroyed entities stale, even once their index is reused
+typedef SlotHandle Entity;
+
+static const Entity NULL_ENTITY = INVALID_SLOT_HANDLE;
+
+#endif
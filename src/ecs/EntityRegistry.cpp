@@ -0,0 +1,29 @@
+#include "EntityRegistry.hpp"
+
+EntityRegistry::EntityRegistry() {}
+
+EntityRegistry::~EntityRegistry() {}
+
+Entity EntityRegistry::create() { return entities.insert(true); }
+
+void EntityRegistry::destroy(const Entity &entity) {
+	if (!entities.remove(entity)) return;
+	transforms.remove(entity);
+	movers.remove(entity);
+	sprites.remove(entity);
+	colliders.remove(entity);
+	animators.remove(entity);
+}
+
+bool EntityRegistry::isAlive(const Entity &entity) const { return entities.contains(entity); }
+
+void EntityRegistry::clear() {
+	transforms.clear();
+	movers.clear();
+	sprites.clear();
+	colliders.clear();
+	animators.clear();
+	entities.clear();
+}
+
+unsigned int EntityRegistry::size() const { return entities.size(); }
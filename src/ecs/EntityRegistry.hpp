@@ -0,0 +1,33 @@
+#ifndef ENTITY_REGISTRY_HPP
+#define ENTITY_REGISTRY_HPP
+
+#include "Components.hpp"
+
+/**
+ * Hands out entity ids and keeps one pool per component type
+ * Destroying an entity takes it out of every pool
+ */
+class EntityRegistry {
+public:
+	EntityRegistry();
+	~EntityRegistry();
+
+	Entity create();
+	void destroy(const Entity &entity);
+	bool isAlive(const Entity &entity) const;
+	void clear();
+
+	//Number of live entities
+	unsigned int size() const;
+
+	TransformPool transforms;
+	MoverPool movers;
+	SpriteRefPool sprites;
+	ColliderPool colliders;
+	AnimatorPool animators;
+
+private:
+	SlotMap<bool> entities;
+};
+
+#endif
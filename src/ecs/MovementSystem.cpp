@@ -0,0 +1,215 @@
+#include "MovementSystem.hpp"
+
+#include "EntityRegistry.hpp"
+#include "../map/Maps.hpp"
+#include "../util/Constants.hpp"
+
+static void directionOffset(uint8_t direction, int &dx, int &dy) {
+	dx = 0; dy = 0;
+	switch (direction) {
+	case LEFT: dx = -1; break;
+	case RIGHT: dx = 1; break;
+	case UP: dy = -1; break;
+	case DOWN: dy = 1; break;
+	default: break;
+	}
+}
+
+MovementSystem::MovementSystem() : width(0), height(0), tileWidth(1), tileHeight(1), heldTile(-1), heldTarget(-1) {}
+
+MovementSystem::~MovementSystem() {}
+
+void MovementSystem::setMap(const Map *map, EntityRegistry &registry) {
+	walkable.clear();
+	occupied.clear();
+	awake.clear();
+	updated.clear();
+	for (unsigned int i = 0; i < registry.transforms.size(); i++) registry.transforms.awake[i] = false;
+	for (unsigned int i = 0; i < registry.transforms.size(); i++) wake(registry, registry.transforms.getEntity(i));
+	width = height = 0;
+	tileWidth = tileHeight = 1;
+	heldTile = heldTarget = -1;
+	if (map == NULL) return;
+	width = map->getWidth();
+	height = map->getHeight();
+	tileWidth = map->getTileWidth();
+	tileHeight = map->getTileHeight();
+
+	//Same rule as the player, a tile is a wall if any layer has something other than floor on it
+	walkable.assign(width * height, true);
+	occupied.assign(width * height, 0);
+	for (unsigned int layer = 0; layer < map->getNumberOfLayers(); layer++) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				Tile *tile = map->getTile(layer, x, y);
+				if (tile != NULL &&
+					tile->getTileType() != Constants::TILE_TYPE_FLOOR &&
+					tile->getTileType() != Constants::TILE_TYPE_FLOWER &&
+					tile->getTileType() != Constants::TILE_TYPE_GRASS) {
+					walkable[tileIndex(x, y)] = false;
+				}
+			}
+		}
+	}
+
+	//Whatever is already on the map takes its tile, reservations were for the old map
+	const ColliderPool &colliders = registry.colliders;
+	for (unsigned int i = 0; i < colliders.size(); i++) {
+		unsigned int transform = registry.transforms.indexOf(colliders.getEntity(i));
+		if (transform == ComponentPool::NO_COMPONENT) continue;
+		int index = tileIndex(registry.transforms.tileX[transform], registry.transforms.tileY[transform]);
+		if (index >= 0) occupied[index]++;
+	}
+}
+
+void MovementSystem::wake(EntityRegistry &registry, const Entity &entity) {
+	unsigned int transform = registry.transforms.indexOf(entity);
+	if (transform == ComponentPool::NO_COMPONENT || registry.transforms.awake[transform]) return;
+	registry.transforms.awake[transform] = true;
+	awake.push_back(entity);
+}
+
+void MovementSystem::place(EntityRegistry &registry, const Entity &entity) {
+	unsigned int collider = registry.colliders.indexOf(entity);
+	unsigned int transform = registry.transforms.indexOf(entity);
+	if (collider == ComponentPool::NO_COMPONENT || transform == ComponentPool::NO_COMPONENT) return;
+	int index = tileIndex(registry.transforms.tileX[transform], registry.transforms.tileY[transform]);
+	if (index >= 0) occupied[index]++;
+}
+
+void MovementSystem::release(EntityRegistry &registry, const Entity &entity) {
+	unsigned int collider = registry.colliders.indexOf(entity);
+	unsigned int transform = registry.transforms.indexOf(entity);
+	if (collider == ComponentPool::NO_COMPONENT || transform == ComponentPool::NO_COMPONENT) return;
+	int index = tileIndex(registry.transforms.tileX[transform], registry.transforms.tileY[transform]);
+	if (index >= 0 && occupied[index] > 0) occupied[index]--;
+	int reserved = registry.colliders.reservedTile[collider];
+	if (reserved >= 0 && occupied[reserved] > 0) occupied[reserved]--;
+	registry.colliders.reservedTile[collider] = -1;
+}
+
+void MovementSystem::hold(int tileX, int tileY, int targetX, int targetY) {
+	int tile = tileIndex(tileX, tileY), target = tileIndex(targetX, targetY);
+	if (tile == heldTile && target == heldTarget) return;
+	if (heldTile >= 0 && occupied[heldTile] > 0) occupied[heldTile]--;
+	if (heldTarget >= 0 && occupied[heldTarget] > 0) occupied[heldTarget]--;
+	heldTile = tile;
+	heldTarget = target;
+	if (heldTile >= 0) occupied[heldTile]++;
+	if (heldTarget >= 0) occupied[heldTarget]++;
+}
+
+bool MovementSystem::update(EntityRegistry &registry, unsigned int stepUs) {
+	MoverPool &movers = registry.movers;
+	TransformPool &transforms = registry.transforms;
+	bool anyMoving = false;
+	moveEnds.clear();
+	updated.clear();
+	for (unsigned int a = 0; a < awake.size();) {
+		Entity entity = awake[a];
+		unsigned int transform = transforms.indexOf(entity);
+
+		//Destroyed since it woke up
+		if (transform == ComponentPool::NO_COMPONENT) {
+			awake[a] = awake.back();
+			awake.pop_back();
+			continue;
+		}
+		updated.push_back(entity);
+
+		bool moving = false;
+		unsigned int i = movers.indexOf(entity);
+		if (i != ComponentPool::NO_COMPONENT) {
+			movers.sinceTickUs[i] += stepUs;
+			while (movers.sinceTickUs[i] >= movers.tickTimeUs[i]) {
+				movers.sinceTickUs[i] -= movers.tickTimeUs[i];
+				transforms.previousPosX[transform] = transforms.posX[transform];
+				transforms.previousPosY[transform] = transforms.posY[transform];
+				if (movers.moving[i]) step(registry, i, transform);
+			}
+
+			//Still drawing its way to where the last step left it
+			moving = movers.moving[i] 
+				|| transforms.posX[transform] != transforms.previousPosX[transform] 
+				|| transforms.posY[transform] != transforms.previousPosY[transform];
+		}
+		anyMoving = anyMoving || moving;
+
+		//Asleep once it stands still where it was last drawn, it is in updated this once more so its sprite catches up
+		if (!moving && transforms.drawX[transform] == transforms.posX[transform] 
+			&& transforms.drawY[transform] == transforms.posY[transform]) {
+			transforms.awake[transform] = false;
+			awake[a] = awake.back();
+			awake.pop_back();
+		}
+		else {
+			a++;
+		}
+	}
+	return anyMoving;
+}
+
+void MovementSystem::step(EntityRegistry &registry, unsigned int mover, unsigned int transform) {
+	MoverPool &movers = registry.movers;
+	TransformPool &transforms = registry.transforms;
+	int dx, dy;
+	directionOffset(movers.direction[mover], dx, dy);
+	int tileSize = dx != 0 ? tileWidth : tileHeight;
+
+	//Starting the walk to the next tile, take it or bump into whatever is there
+	if (movers.displacement[mover] == 0) {
+		int targetX = transforms.tileX[transform] + dx, targetY = transforms.tileY[transform] + dy;
+		movers.blocked[mover] = !isWalkable(targetX, targetY);
+		unsigned int collider = registry.colliders.indexOf(movers.getEntity(mover));
+		if (!movers.blocked[mover] && collider != ComponentPool::NO_COMPONENT) {
+			registry.colliders.reservedTile[collider] = tileIndex(targetX, targetY);
+			occupied[registry.colliders.reservedTile[collider]]++;
+		}
+	}
+	if (!movers.blocked[mover]) {
+		transforms.posX[transform] += dx * movers.speed[mover];
+		transforms.posY[transform] += dy * movers.speed[mover];
+	}
+	movers.displacement[mover] += movers.speed[mover];
+	if (movers.displacement[mover] < tileSize) return;
+
+	//Made it to the next tile (or finished bumping), keep going if there was another move queued
+	if (!movers.blocked[mover]) {
+		unsigned int collider = registry.colliders.indexOf(movers.getEntity(mover));
+		if (collider != ComponentPool::NO_COMPONENT) {
+			int left = tileIndex(transforms.tileX[transform], transforms.tileY[transform]);
+			if (left >= 0 && occupied[left] > 0) occupied[left]--;
+			registry.colliders.reservedTile[collider] = -1;
+		}
+		transforms.tileX[transform] += dx;
+		transforms.tileY[transform] += dy;
+		transforms.posX[transform] = transforms.tileX[transform] * tileWidth;
+		transforms.posY[transform] = transforms.tileY[transform] * tileHeight;
+	}
+	moveEnds.push_back(movers.getEntity(mover));
+	movers.displacement[mover] = 0;
+	movers.blocked[mover] = false;
+	movers.walkLeft[mover] = !movers.walkLeft[mover];
+	movers.direction[mover] = movers.nextDirection[mover];
+	movers.nextDirection[mover] = NONE;
+	movers.moving[mover] = movers.direction[mover] != NONE;
+	if (movers.moving[mover]) movers.facing[mover] = movers.direction[mover];
+}
+
+const std::vector<Entity> & MovementSystem::getMoveEnds() const { return moveEnds; }
+
+const std::vector<Entity> & MovementSystem::getUpdated() const { return updated; }
+
+bool MovementSystem::isWalkable(int tileX, int tileY) const {
+	int index = tileIndex(tileX, tileY);
+	return index >= 0 && walkable[index] && occupied[index] == 0;
+}
+
+int MovementSystem::getTileWidth() const { return tileWidth; }
+
+int MovementSystem::getTileHeight() const { return tileHeight; }
+
+int MovementSystem::tileIndex(int tileX, int tileY) const {
+	if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height) return -1;
+	return tileY * width + tileX;
+}
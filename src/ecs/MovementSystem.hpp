@@ -0,0 +1,63 @@
+#ifndef MOVEMENT_SYSTEM_HPP
+#define MOVEMENT_SYSTEM_HPP
+
+#include <vector>
+#include <stdint.h>
+#include "Entity.hpp"
+
+class EntityRegistry;
+class Map;
+
+/**
+ * Walks movers from tile to tile
+ * Which tiles of the map can be walked on is worked out once per map instead of on every step,
+ * and entities with colliders keep the tile they stand on (and the one they walk onto) taken
+ * Only awake entities are looked at: they wake up when they are made, moved or told to walk
+ * and go back to sleep once they stand still, so a step costs as much as the entities that changed
+ */
+class MovementSystem {
+public:
+	MovementSystem();
+	~MovementSystem();
+
+	//Use a new map, every collider in the registry takes its tile on it and every entity wakes up
+	void setMap(const Map *map, EntityRegistry &registry);
+
+	//Look at the entity in the next updates until it is standing still again (it was made, moved or told to walk)
+	void wake(EntityRegistry &registry, const Entity &entity);
+
+	//Move an entity's collider on or off the grid (when it is created, teleported or destroyed)
+	void place(EntityRegistry &registry, const Entity &entity);
+	void release(EntityRegistry &registry, const Entity &entity);
+
+	//Keep tiles taken for something that walks on its own (the player), what it held before is given back
+	//targetX, targetY is the tile it walks onto, outside the map (ie: -1, -1) for none
+	void hold(int tileX, int tileY, int targetX, int targetY);
+
+	//Run one simulation step of stepUs microseconds, returns true while anything is walking
+	bool update(EntityRegistry &registry, unsigned int stepUs);
+
+	//Every entity that got to its next tile (or bumped into something) during the last update
+	const std::vector<Entity> & getMoveEnds() const;
+
+	//Every entity the last update looked at, including the ones that went to sleep, their sprites may have changed
+	const std::vector<Entity> & getUpdated() const;
+
+	//Inside the map, not a wall and nobody standing there
+	bool isWalkable(int tileX, int tileY) const;
+
+	int getTileWidth() const;
+	int getTileHeight() const;
+
+private:
+	int width, height, tileWidth, tileHeight;
+	int heldTile, heldTarget;
+	std::vector<uint8_t> walkable;
+	std::vector<uint16_t> occupied;
+	std::vector<Entity> moveEnds, awake, updated;
+
+	int tileIndex(int tileX, int tileY) const;
+	void step(EntityRegistry &registry, unsigned int mover, unsigned int transform);
+};
+
+#endif
@@ -1,25 +1,60 @@
 #include "BaseGameObject.hpp"
 
-#include "../util/Timer.hpp"
+#include "../util/Constants.hpp"
+#include "../util/Trace.hpp"
 
 BaseGameObject::BaseGameObject()
-	: tickTimer(NULL) {}
+	: scheduleHandle(INVALID_SLOT_HANDLE), 
+	tickHandle(INVALID_SLOT_HANDLE), 
+	timers(NULL), 
+	tickTimeUs(0), 
+	nextObjectTickUs(0) {}
 
 BaseGameObject::BaseGameObject(unsigned int tickTime) 
-	: tickTimer(new Timer(tickTime)) {}
+	: scheduleHandle(INVALID_SLOT_HANDLE), 
+	tickHandle(INVALID_SLOT_HANDLE), 
+	timers(NULL), 
+	tickTimeUs(tickTime * 1000), 
+	nextObjectTickUs(0) {}
 
-BaseGameObject::~BaseGameObject() {
-	if (tickTimer != NULL) {
-		delete tickTimer;
-		tickTimer = NULL;
+BaseGameObject::~BaseGameObject() {}
+
+unsigned int BaseGameObject::tick(Game *game) {
+	TRACE_SCOPE("BaseGameObject::tick");
+	if (tickTimeUs == 0) {
+		onGameTick(game);
+		return Constants::GAME_TICK_MICROSECONDS;
+	}
+
+	//Ticks shorter than a step run more than once
+	unsigned long long now = timers->getTimeMicroseconds();
+	while (nextObjectTickUs <= now) {
+		nextObjectTickUs += tickTimeUs;
+		onSavePreviousState();
+		onObjectTick(game);
 	}
+	return static_cast<unsigned int> (nextObjectTickUs - now);
+}
+
+float BaseGameObject::getObjectTickProgress(float stepProgress) const {
+	if (tickTimeUs == 0 || timers == NULL) return 1.0f;
+	long long sinceObjectTickUs = static_cast<long long> (timers->getTimeMicroseconds())
+		- static_cast<long long> (nextObjectTickUs - tickTimeUs);
+	float progress = (sinceObjectTickUs + stepProgress * Constants::GAME_TICK_MICROSECONDS) / tickTimeUs;
+	if (progress < 0.0f) return 0.0f;
+	return progress > 1.0f ? 1.0f : progress;
+}
+
+TimerHandle BaseGameObject::callAfter(unsigned int ms, const TimerCallback &callback) {
+	if (timers == NULL) return INVALID_SLOT_HANDLE;
+	return timers->schedule(ms * 1000, callback);
 }
 
-void BaseGameObject::tick(Game *game) {
-	if (tickTimer != NULL && tickTimer->check()) { onObjectTick(game); }
-	onGameTick(game);
+void BaseGameObject::cancelCall(TimerHandle &handle) {
+	if (timers != NULL) timers->cancel(handle);
+	handle = INVALID_SLOT_HANDLE;
 }
 
 void BaseGameObject::tickInBackground() { onTickInBackground(); }
 
-void BaseGameObject::draw(Window *win) { onDraw(win); }
\ No newline at end of file
+void BaseGameObject::draw(Window *win) { onDraw(win); }
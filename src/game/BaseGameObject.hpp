@@ -1,9 +1,10 @@
 #ifndef BASE_GAME_OBJ
 #define BASE_GAME_OBJ
 
+#include "../util/TimerWheel.hpp"
+
 class Game;
 class Window;
-class Timer;
 
 class BaseGameObject {
 public:
@@ -11,7 +12,9 @@ public:
 	BaseGameObject(unsigned int tickTime);
 	virtual ~BaseGameObject();
 
-	void tick(Game *game);
+	//Run the object when its timer goes off, returns how many microseconds until it is due again
+	//onObjectTick runs every tickTime ms of simulated time, objects without a tick time run onGameTick every step
+	unsigned int tick(Game *game);
 	void draw(Window *win);
 	void tickInBackground();
 
@@ -19,10 +22,30 @@ protected:
 	virtual void onGameTick(Game *game) {}
 	virtual void onObjectTick(Game *game) {}
 	virtual void onDraw(Window *win) {}
+
+	//Runs on a worker thread while the frame is drawn, alongside other objects' background ticks
 	virtual void onTickInBackground() {}
 
+	//Called right before each object tick, so the state it leaves behind can be interpolated
+	virtual void onSavePreviousState() {}
+
+	//How far drawing is between the last object tick and the next one (0 to 1)
+	//stepProgress is how far the game is into the current simulation step
+	float getObjectTickProgress(float stepProgress) const;
+
+	//Call back once after ms of simulated time, does nothing until the object has been scheduled
+	TimerHandle callAfter(unsigned int ms, const TimerCallback &callback);
+	void cancelCall(TimerHandle &handle);
+
 private:
-	Timer *tickTimer;
+	//Game keeps the handles to the object's spot in the tick list and its next tick on the timer wheel
+	friend class Game;
+	SlotHandle scheduleHandle;
+	TimerHandle tickHandle;
+	TimerWheel *timers;
+
+	unsigned int tickTimeUs;
+	unsigned long long nextObjectTickUs;
 };
 
 #endif
\ No newline at end of file
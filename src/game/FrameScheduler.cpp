@@ -0,0 +1,73 @@
+#include "FrameScheduler.hpp"
+
+#include <SDL2/SDL_events.h>
+#include "../util/Constants.hpp"
+#include "../util/Util.hpp"
+
+typedef std::chrono::microseconds Microseconds;
+
+FrameScheduler::FrameScheduler(unsigned int framePeriod)
+	: framePeriodUs(framePeriod),
+	nextFrame(Clock::now()),
+	deadlines(0),
+	missedDeadlines(0),
+	droppedFrames(0),
+	worstLatenessUs(0),
+	totalLatenessUs(0) {}
+
+FrameScheduler::~FrameScheduler() {}
+
+bool FrameScheduler::isFrameDue() {
+	if (framePeriodUs == 0) return true;
+	Clock::time_point now = Clock::now();
+	if (now < nextFrame) return false;
+
+	//Keep frames on a fixed cadence, unless a whole frame was missed, then start over from now
+	nextFrame += Microseconds(framePeriodUs);
+	if (nextFrame <= now) {
+		droppedFrames++;
+		nextFrame = now + Microseconds(framePeriodUs);
+	}
+	return true;
+}
+
+void FrameScheduler::waitForNextDeadline(unsigned int tickDueInUs) {
+	Clock::time_point deadline = Clock::now() + Microseconds(tickDueInUs);
+	if (framePeriodUs != 0 && nextFrame < deadline) deadline = nextFrame;
+
+	//Coarse sleep, input wakes the loop straight away
+	Clock::time_point now = Clock::now();
+	Microseconds remaining = std::chrono::duration_cast<Microseconds>(deadline - now);
+	if (remaining.count() > Constants::GAME_SPIN_MICROSECONDS) {
+		int sleepMs = static_cast<int> ((remaining.count() - Constants::GAME_SPIN_MICROSECONDS) / 1000);
+		if (sleepMs > 0 && SDL_WaitEventTimeout(NULL, sleepMs) == 1) return;
+	}
+
+	//Spin for the rest so the deadline is not overslept
+	while ((now = Clock::now()) < deadline) {}
+
+	unsigned int latenessUs = static_cast<unsigned int> (std::chrono::duration_cast<Microseconds>(now - deadline).count());
+	deadlines++;
+	totalLatenessUs += latenessUs;
+	if (latenessUs > worstLatenessUs) worstLatenessUs = latenessUs;
+	if (latenessUs > Constants::GAME_LATE_DEADLINE_MICROSECONDS) missedDeadlines++;
+}
+
+void FrameScheduler::waitForNextFrame(unsigned int tickDueInUs) {
+	//The next frame is never more than a period away, with vsync the next tick is what makes a frame worth drawing
+	waitForNextDeadline(framePeriodUs == 0 ? tickDueInUs : framePeriodUs);
+}
+
+unsigned int FrameScheduler::getDeadlines() const { return deadlines; }
+unsigned int FrameScheduler::getMissedDeadlines() const { return missedDeadlines; }
+unsigned int FrameScheduler::getDroppedFrames() const { return droppedFrames; }
+unsigned int FrameScheduler::getWorstLatenessUs() const { return worstLatenessUs; }
+
+void FrameScheduler::logStatistics() const {
+	std::string message = "Frame pacing: " + std::to_string(deadlines) + " deadlines, "
+		+ std::to_string(missedDeadlines) + " missed, "
+		+ std::to_string(droppedFrames) + " dropped frames, average lateness "
+		+ std::to_string(deadlines == 0 ? 0 : totalLatenessUs / deadlines) + "us, worst "
+		+ std::to_string(worstLatenessUs) + "us";
+	Util::log(SDL_LOG_PRIORITY_INFO, message);
+}
@@ -0,0 +1,44 @@
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <chrono>
+
+/**
+ * Paces the game loop
+ * Works out when the next frame or tick is due, sleeps until just before then
+ * and spins for the rest so the loop wakes up on time
+ * Pending input ends the wait immediately
+ */
+class FrameScheduler {
+public:
+	//A frame period of 0 makes every frame due, for when vsync paces the frames
+	FrameScheduler(unsigned int framePeriodUs);
+	~FrameScheduler();
+
+	//Tell if a frame should be drawn now, moves the frame deadline along when it is
+	bool isFrameDue();
+
+	//Wait until the next frame or the next tick (tickDueInUs from now) is due
+	void waitForNextDeadline(unsigned int tickDueInUs);
+
+	//Wait until the next frame is due, for when ticks run on another thread
+	//With vsync any frame is due, so it waits for the next tick instead (tickDueInUs from now), nothing new is drawn before it
+	void waitForNextFrame(unsigned int tickDueInUs);
+
+	//Missed deadline statistics
+	unsigned int getDeadlines() const;
+	unsigned int getMissedDeadlines() const;
+	unsigned int getDroppedFrames() const;
+	unsigned int getWorstLatenessUs() const;
+	void logStatistics() const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	unsigned int framePeriodUs;
+	Clock::time_point nextFrame;
+	unsigned int deadlines, missedDeadlines, droppedFrames, worstLatenessUs;
+	unsigned long long totalLatenessUs;
+};
+
+#endif
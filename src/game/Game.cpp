@@ -1,46 +1,99 @@
 #include "Game.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstring>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include "BaseGameObject.hpp"
+#include "FrameScheduler.hpp"
+#include "InputRecording.hpp"
 #include "../sprite/SpriteSheet.hpp"
 #include "../sprite/Font.hpp"
 #include "../util/Constants.hpp"
 #include "../util/Timer.hpp"
+#include "../util/TimerWheel.hpp"
 #include "../util/Util.hpp"
 #include "../util/FileUtil.hpp"
+#include "../util/SystemTimings.hpp"
+#include "../util/AllocationTracker.hpp"
+#include "../util/Trace.hpp"
 #include "../screen/LaunchScreen.hpp"
+#include "../screen/WorldScreen.hpp"
+#include "../screen/PerfHud.hpp"
+#include "../world/CrowdStress.hpp"
 #include "../map/MapLoader.hpp"
 
-static int runInBackgroundThread(void *gahoodmon);
-
 Game::Game() 
     : running(false), 
+      headless(false), 
       window(NULL), 
-      fpsTimer(NULL), 
-      backgroundThread(NULL), 
+      tickTimer(NULL), 
+      frameScheduler(NULL), 
+      tickAccumulator(0), 
+      jobs(NULL), 
+      backgroundTimer(NULL), 
       currentScreen(NULL), 
-      nextScreen(NULL) {}
+      simulationThread(NULL), 
+      simulationLock(NULL), 
+      input(Constants::GAME_INPUT_QUEUE_SIZE), 
+      inputRecorder(NULL), 
+      inputReplay(NULL), 
+      lastStepUs(0), 
+      renderStatsLogged(false), 
+      perfHud(NULL), 
+      perfHudShown(false), 
+      lastFrameUs(0), 
+      scheduledObjects(0), 
+      hudCosts(), 
+      crowdStress(NULL), 
+      timingCosts(false), 
+      stepsTimed(0), 
+      stepNanosecondsTimed(0), 
+      framesTimed(0), 
+      renderNanosecondsTimed(0), 
+      timers(NULL), 
+      events(Constants::GAME_EVENT_QUEUE_SIZE), 
+      resourceTimer(NULL), 
+      framesSinceScreenChange(0), 
+      assetsChanged(false), 
+      assetLock(NULL) {
+    pendingInput.eventCount = 0;
+    memset(stepKeys, 0, sizeof(stepKeys));
+}
 
 Game::~Game() {}
 
+typedef std::chrono::steady_clock Clock;
+
+static long long nowMicroseconds() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
 void Game::run() {
     init();
+    requestNewScreen(new LaunchScreen());
     while(running) {
         update();
-        Util::sleep(Constants::GAME_LOOP_DELAY);
+
+        //Only frames are due on the main thread while the simulation has its own
+        if(running && simulationThread != NULL) frameScheduler->waitForNextFrame(getMicrosecondsUntilNextStep());
+        else if(running) frameScheduler->waitForNextDeadline(getMicrosecondsUntilNextTick());
     }
     deinit();
 }
 
-void Game::runInBackground() {
-	for (unsigned int i = 0; i < updatables.size(); i++) {
-		updatables[i]->tickInBackground();
-	}
-}
-
 void Game::init() {
+    TRACE_THREAD("main");
+    if(!tracePath.empty()) Trace::setEnabled(true);
+
+    //Nothing is shown or heard headless, SDL's dummy drivers work without a display or a sound card
+    if(headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    }
     
     //Init SDL2
     if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
@@ -53,106 +106,406 @@ void Game::init() {
         Util::fatalSDLError("Failed to initialize SDL2 TTF");
     }
 
-	//Create the timers
+	//Create the timers, vsync paces the frames by itself
 	const int MILLISECONDS_PER_SECOND = 1000;
-	int msPerFrame = MILLISECONDS_PER_SECOND / Constants::TARGET_FPS;
-	fpsTimer = new Timer(msPerFrame);
+	const int MICROSECONDS_PER_SECOND = 1000000;
+	frameScheduler = new FrameScheduler(Constants::GAME_VSYNC ? 0 : MICROSECONDS_PER_SECOND / Constants::TARGET_FPS);
 	int msPerTick = MILLISECONDS_PER_SECOND / Constants::TARGET_TICKS_PER_SECOND;
 	tickTimer = new Timer(msPerTick);
+	backgroundTimer = new Timer(Constants::GAME_BACKGROUND_LOOP_DELAY);
+	resourceTimer = new Timer(Constants::GAME_RESOURCE_CHECK_DELAY);
+	timers = new TimerWheel(Constants::GAME_TICK_MICROSECONDS);
+
+    //Start the worker threads
+    jobs = new JobSystem(Constants::GAME_JOB_WORKERS);
   
     //Create the window
-    window = new Window();
+    window = new Window(headless);
+    window->setLogRenderStats(renderStatsLogged);
     running = true;
 
-    //Load the fonts
+    //Find the fonts and images, they are loaded when something asks for them (or a screen preloads them)
+    assetLock = SDL_CreateMutex();
+    if(assetLock == NULL) Util::fatalSDLError("Failed to create the asset lock");
     std::vector<std::string> fontFiles = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::FONT_FILE_EXTENSION);
     for(size_t i = 0; i < fontFiles.size(); i++) {
-        std::string fName = FileUtil::getFileName(fontFiles[i].c_str());
-        fonts.insert(std::pair<std::string, Font *> (fName, new Font(fontFiles[i].c_str())));
+        fonts.add(FileUtil::getFileName(fontFiles[i].c_str()), fontFiles[i]);
     }
-    Util::log(SDL_LOG_PRIORITY_INFO, "Loaded all fonts!");
-    
-    //Create the background thread
-    backgroundThread = SDL_CreateThread(runInBackgroundThread, Constants::GAME_THREAD_NAME, this);
-    if(backgroundThread == NULL) {
-        Util::fatalSDLError("Could not create the background thread");
+    std::vector<std::string> imageFiles = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::IMAGE_FILE_EXTENSION);
+    for(size_t i = 0; i < imageFiles.size(); i++) {
+        spriteSheets.add(FileUtil::getFileName(imageFiles[i].c_str()), imageFiles[i]);
     }
+    Util::log(SDL_LOG_PRIORITY_INFO, "Found " + std::to_string(fontFiles.size()) + " fonts and " 
+        + std::to_string(imageFiles.size()) + " images!");
+
+    //Screens preload the maps on the workers, the loader has to exist before any of them run
+    MapLoader::getInstance();
     
-    //Start the first screen
-    requestNewScreen(new LaunchScreen());
+    //Start the simulation thread, it waits for the first screen
+    simulationLock = SDL_CreateMutex();
+    if(simulationLock == NULL) Util::fatalSDLError("Failed to create the simulation lock");
+    if(Constants::GAME_SIMULATION_THREAD && !headless) {
+        simulationThread = SDL_CreateThread(runSimulation, Constants::GAME_SIMULATION_THREAD_NAME, this);
+        if(simulationThread == NULL) Util::fatalSDLError("Could not create the simulation thread");
+    }
 }
 
 void Game::update() {
-   
-    /* Check to see if there's a screen change
-     * Will not change unless there was a request to */
+    TRACE_SCOPE("Game::update");
+
+    /* Hand the input to the simulation, the game handles quitting itself */
+    pollInput();
+
+    /* Everything the simulation must not see half done happens while it is between steps:
+     * screen changes, what other threads handed to the main thread (job continuations and events),
+     * unloading the unused assets and, without a simulation thread, the simulation itself */
+    SDL_LockMutex(simulationLock);
     changeScreens();
+    jobs->runMainThreadJobs();
+    handleEvents();
+    if(resourceTimer->check()) evictUnusedResources();
+    if(simulationThread == NULL) simulate();
+    scheduledObjects = updatables.size();
+    SDL_UnlockMutex(simulationLock);
 
-	/* Update every registered game object */
-	if (tickTimer->check()) {
-		for (unsigned int i = 0; i < updatables.size(); i++) {
-			updatables[i]->tick(this);
-		}
-	}
+    /* Draw the newest snapshots of the visible screens (or the blank window, presented only once)
+     * between the last simulation step and the next one, paused screens keep their last one */
+    if(frameScheduler->isFrameDue()) {
+        drawFrame();
+        endAllocationFrame();
+    }
+}
 
-    /* If current screen exists 
-     * Have it handle input 
-     * check to see if it needs to be drawn 
-     * and update the screen as well */
-    if(currentScreen != NULL) {
-		currentScreen->handleInput(this);
-        if(fpsTimer->check()) {
-            //Render to the window
-            window->render(currentScreen);
-        }
+void Game::drawFrame() {
+    if(perfHudShown) samplePerformance();
+    for(unsigned int i = 0; i < visibleScreens.size(); i++) visibleScreens[i]->acquireSnapshot();
+    window->setInterpolation(getStepProgress());
+    if(!timingCosts.load(std::memory_order_relaxed)) {
+        window->render(visibleScreens);
+        return;
+    }
+    Clock::time_point start = Clock::now();
+    if(window->render(visibleScreens)) {
+        std::chrono::nanoseconds took = Clock::now() - start;
+        renderNanosecondsTimed.fetch_add(took.count(), std::memory_order_relaxed);
+        framesTimed.fetch_add(1, std::memory_order_relaxed);
     }
+}
 
-    /* If current screen does not exist
-     * handle the input of quitting
-     */
-    else {
-        window->render(NULL);
-        SDL_Event e;
-        while(SDL_PollEvent(&e)) {
-            if(e.type == SDL_QUIT)
-                quit();
+void Game::endAllocationFrame() {
+    //Once the screens have settled nothing should be loading or changing anymore
+    bool steadyState = screenChanges.empty() && !assetsChanged && spriteSheetLoads.isDone()
+        && framesSinceScreenChange >= Constants::GAME_STEADY_STATE_FRAMES;
+    AllocationTracker::endFrame(steadyState);
+    framesSinceScreenChange++;
+    assetsChanged = false;
+}
+
+void Game::pollInput() {
+    SDL_Event e;
+    while(SDL_PollEvent(&e)) {
+        if(e.type == SDL_QUIT) {
+            quit();
+            continue;
+        }
+
+        //The window contents may have been lost, redraw everything
+        if(e.type == SDL_WINDOWEVENT) window->invalidate();
+
+        if(e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F3 && !e.key.repeat) togglePerfHud();
+
+        //Save what was traced so far
+        if(e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F12 && !tracePath.empty()) {
+            Trace::writeChromeTrace(tracePath.c_str());
         }
+        if(pendingInput.eventCount < InputFrame::MAX_EVENTS) pendingInput.events[pendingInput.eventCount++] = e;
     }
+    memcpy(pendingInput.keys, SDL_GetKeyboardState(NULL), sizeof(pendingInput.keys));
+
+    //While the simulation is behind, keep adding to the same frame
+    if(input.push(pendingInput)) pendingInput.eventCount = 0;
 }
 
-void Game::schedule(BaseGameObject *obj) {
-	if (obj != NULL) updatables.push_back(obj);
+void Game::simulate() {
+
+	/* Window events first, the steps see them straight away
+	 * A replay stands in for all of the live input */
+	input.drain([this](const InputFrame &frame) {
+		memcpy(stepKeys, frame.keys, sizeof(stepKeys));
+		if (currentScreen != NULL && inputReplay == NULL) currentScreen->handleInput(this, frame);
+	});
+
+	/* Run a fixed length simulation step for every step's worth of time that passed,
+	 * each step only runs the objects whose timers are due, then publishes a snapshot to draw
+	 * Falling too far behind drops time instead of trying to catch up */
+	tickAccumulator += tickTimer->lapMicroseconds();
+	const unsigned int maxAccumulated = Constants::GAME_MAX_TICKS_PER_UPDATE * Constants::GAME_TICK_MICROSECONDS;
+	if (tickAccumulator > maxAccumulated) tickAccumulator = maxAccumulated;
+	while (tickAccumulator >= Constants::GAME_TICK_MICROSECONDS) {
+		step();
+		tickAccumulator -= Constants::GAME_TICK_MICROSECONDS;
+		lastStepUs = nowMicroseconds() - tickAccumulator;
+	}
+
+	/* Tick the objects in the background on the workers */
+	if (backgroundTimer->check()) runBackgroundTicks();
 }
 
-void Game::unschedule(BaseGameObject *obj) {
-	if (obj != NULL) {
-		for (unsigned int i = 0; i < updatables.size(); i++) {
-			//Remove the object from the list of updatables
-			if (updatables[i] == obj) {
-				updatables.erase(updatables.begin() + i);
-				break;
+void Game::step() {
+	TRACE_SCOPE("Game::step");
+	AllocationScope allocations(ALLOCATION_WORLD);
+	bool timed = timingCosts.load(std::memory_order_relaxed);
+	Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+	handleStepInput();
+	{
+		SystemTimer timer(SYSTEM_OBJECT_TICKS);
+		timers->advance();
+	}
+	if (currentScreen != NULL) {
+		SystemTimer timer(SYSTEM_SNAPSHOTS);
+		currentScreen->publishSnapshot(this);
+	}
+	if (timed) {
+		std::chrono::nanoseconds took = Clock::now() - start;
+		stepNanosecondsTimed.fetch_add(took.count(), std::memory_order_relaxed);
+		stepsTimed.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Game::runBackgroundTicks() {
+	//The tick list can't change until they are done, the wait only helps with the background ticks themselves
+	//so nothing else queued (preloads, image decodes) runs while the simulation holds its lock
+	SystemTimer timer(SYSTEM_BACKGROUND_TICKS);
+	tickInBackground();
+	jobs->wait(&backgroundTicks);
+}
+
+void Game::handleStepInput() {
+	SystemTimer timer(SYSTEM_INPUT);
+
+	//The keyboard is looked at exactly once per step, so a recording plays back the same on any machine
+	if (inputReplay != NULL && !inputReplay->play(stepKeys)) {
+		memset(stepKeys, 0, sizeof(stepKeys));
+		if (isRunning()) Util::log(SDL_LOG_PRIORITY_INFO, "The input recording is over!");
+		quit();
+	}
+	if (inputRecorder != NULL) inputRecorder->record(stepKeys);
+	if (currentScreen != NULL) currentScreen->handleKeyInput(this, stepKeys);
+}
+
+int Game::runSimulation(void *data) {
+	Game *game = static_cast<Game *> (data);
+	TRACE_THREAD(Constants::GAME_SIMULATION_THREAD_NAME);
+	while (game->isRunning()) {
+		SDL_LockMutex(game->simulationLock);
+		game->simulate();
+		unsigned int waitUs = game->getMicrosecondsUntilNextTick();
+		SDL_UnlockMutex(game->simulationLock);
+		if (waitUs > 0) std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+	}
+	return 0;
+}
+
+float Game::getStepProgress() const {
+	long long sinceStepUs = nowMicroseconds() - lastStepUs;
+	if (sinceStepUs <= 0) return 0.0f;
+	if (sinceStepUs >= Constants::GAME_TICK_MICROSECONDS) return 1.0f;
+	return static_cast<float> (sinceStepUs) / Constants::GAME_TICK_MICROSECONDS;
+}
+
+unsigned int Game::getMicrosecondsUntilNextTick() {
+	unsigned int pending = tickAccumulator + tickTimer->getElapsedMicroseconds();
+	return pending >= Constants::GAME_TICK_MICROSECONDS ? 0 : Constants::GAME_TICK_MICROSECONDS - pending;
+}
+
+//Without the simulation lock, going by when the simulation thread last stepped
+unsigned int Game::getMicrosecondsUntilNextStep() const {
+	long long sinceStepUs = nowMicroseconds() - lastStepUs;
+	if (sinceStepUs < 0) sinceStepUs = 0;
+	return sinceStepUs >= Constants::GAME_TICK_MICROSECONDS ? 0 : static_cast<unsigned int> (Constants::GAME_TICK_MICROSECONDS - sinceStepUs);
+}
+
+void Game::tickObject(BaseGameObject *obj) {
+	obj->tickHandle = INVALID_SLOT_HANDLE;
+	unsigned int nextTickUs = obj->tick(this);
+
+	//Unless the tick unscheduled the object (or already scheduled it again)
+	if (updatables.contains(obj->scheduleHandle) && !timers->isScheduled(obj->tickHandle)) {
+		armObject(obj, nextTickUs);
+	}
+}
+
+void Game::armObject(BaseGameObject *obj, unsigned int delayMicroseconds) {
+	obj->tickHandle = timers->schedule(delayMicroseconds, [this, obj]() { tickObject(obj); });
+}
+
+void Game::tickInBackground() {
+	unsigned int count = updatables.size();
+	const unsigned int grain = Constants::GAME_BACKGROUND_TICK_GRAIN;
+	for (unsigned int begin = 0; begin < count; begin += grain) {
+		unsigned int end = count - begin < grain ? count : begin + grain;
+		jobs->submit([this, begin, end]() {
+			for (unsigned int i = begin; i < end; i++) {
+				if (updatables[i] != NULL) updatables[i]->tickInBackground();
 			}
-		}
+		}, &backgroundTicks);
 	}
 }
 
+void Game::schedule(BaseGameObject *obj) {
+	if (obj == NULL || updatables.contains(obj->scheduleHandle)) return;
+	obj->scheduleHandle = updatables.insert(obj);
+	obj->timers = timers;
+	obj->nextObjectTickUs = timers->getTimeMicroseconds() + obj->tickTimeUs;
+	armObject(obj, obj->tickTimeUs > 0 ? obj->tickTimeUs : Constants::GAME_TICK_MICROSECONDS);
+}
+
+void Game::unschedule(BaseGameObject *obj) {
+	if (obj == NULL) return;
+	BaseGameObject **scheduled = updatables.get(obj->scheduleHandle);
+
+	//Stale handle, the object is not scheduled
+	if (scheduled == NULL || *scheduled != obj) return;
+	updatables.remove(obj->scheduleHandle);
+	timers->cancel(obj->tickHandle);
+	obj->scheduleHandle = INVALID_SLOT_HANDLE;
+	obj->tickHandle = INVALID_SLOT_HANDLE;
+}
+
 void Game::changeScreens() {
-    if(nextScreen != NULL) {
-        if(currentScreen == NULL) {
-            currentScreen = nextScreen;
-        }
-        else {
-			currentScreen->stop(this);
-            delete currentScreen;
-            currentScreen = nextScreen;
-        }
-        nextScreen = NULL;
-		currentScreen->start(this);
+    //In order, up to the first screen still preloading
+    //Starting a screen can ask for more changes, they go on the end and are looked at straight away
+    unsigned int changed = 0;
+    while(changed < screenChanges.size()) {
+        ScreenChange change = screenChanges[changed];
+        if(change.preloading != NULL && !change.preloading->isDone()) break;
+        changed++;
+        delete change.preloading;
+        applyScreenChange(change);
+    }
+    screenChanges.erase(screenChanges.begin(), screenChanges.begin() + changed);
+}
+
+void Game::applyScreenChange(const ScreenChange &change) {
+    BaseScreen *top = currentScreen;
+    if(change.type == SCREEN_CHANGE_POP && top == NULL) return;
+
+    //Whatever the preload decoded has to be a texture before the screen starts
+    framesSinceScreenChange = 0;
+    addPreloadedSpriteSheets();
+    if(inputRecorder != NULL) inputRecorder->nextScreen();
+    if(inputReplay != NULL) inputReplay->nextScreen();
+
+    switch(change.type) {
+        case SCREEN_CHANGE_REPLACE:
+            if(top != NULL) {
+                top->stop(this);
+                delete top;
+                screens.pop_back();
+            }
+            screens.push_back(change.screen);
+            change.screen->start(this);
+            break;
+        case SCREEN_CHANGE_PUSH:
+            if(top != NULL) top->pause(this);
+            screens.push_back(change.screen);
+            change.screen->start(this);
+            break;
+        case SCREEN_CHANGE_POP:
+            top->stop(this);
+            delete top;
+            screens.pop_back();
+            if(screens.empty()) quit();
+            else screens.back()->resume(this);
+            break;
     }
+    currentScreen = screens.empty() ? NULL : screens.back();
+
+    //Draw from the first screen that hides everything under it
+    size_t firstVisible = screens.size();
+    while(firstVisible > 0 && screens[--firstVisible]->isOverlay()) {}
+    visibleScreens.assign(screens.begin() + firstVisible, screens.end());
+    if(perfHudShown) visibleScreens.push_back(perfHud);
+    window->invalidate();
+}
+
+void Game::togglePerfHud() {
+    if(perfHud == NULL) perfHud = new PerfHud();
+    perfHudShown = !perfHudShown;
+    if(perfHudShown) {
+        perfHud->start(this);
+        visibleScreens.push_back(perfHud);
+        hudCosts = getCosts();
+        lastFrameUs = 0;
+    }
+    else {
+        perfHud->stop(this);
+        visibleScreens.erase(std::remove(visibleScreens.begin(), visibleScreens.end(), perfHud), visibleScreens.end());
+    }
+    timingCosts = perfHudShown || crowdStress != NULL;
+    window->invalidate();
+}
+
+void Game::samplePerformance() {
+    long long nowUs = nowMicroseconds();
+    PerfSample sample;
+    sample.frameUs = lastFrameUs > 0 ? static_cast<unsigned int> (nowUs - lastFrameUs) : 0;
+    GameCosts costs = getCosts();
+    sample.steps = static_cast<unsigned int> (costs.steps - hudCosts.steps);
+    sample.stepNs = costs.stepNanoseconds - hudCosts.stepNanoseconds;
+    hudCosts = costs;
+    sample.scheduledObjects = scheduledObjects;
+    sample.textureBytes = Window::getTextureBytes();
+    sample.drawCalls = window->getRenderStats().getLastFrame().counts[RENDER_COPIES];
+    sample.allocations = AllocationTracker::getLastFrame().getTotalAllocations();
+    perfHud->addSample(sample);
+    lastFrameUs = nowUs;
+}
+
+void Game::requestScreenChange(ScreenChangeType type, BaseScreen *screen) {
+    ScreenChange change;
+    change.type = type;
+    change.screen = screen;
+    change.preloading = NULL;
+    if(screen != NULL) {
+        //Preload, then make the sprite sheets on the main thread once the ones already loading in the background
+        //are done too, the change is ready when that continuation has run (nothing waits for the main thread)
+        JobCounter *preloading = change.preloading = new JobCounter();
+        jobs->submit([this, screen, preloading]() {
+            screen->preload(this);
+            jobs->submitToMainThread([this]() { addPreloadedSpriteSheets(); }, preloading, &spriteSheetLoads);
+        }, preloading);
+    }
+    screenChanges.push_back(change);
 }
 
 void Game::requestNewScreen(BaseScreen *screen) {
-    nextScreen = screen;
+    if(screen != NULL) requestScreenChange(SCREEN_CHANGE_REPLACE, screen);
+}
+
+void Game::pushScreen(BaseScreen *screen) {
+    if(screen != NULL) requestScreenChange(SCREEN_CHANGE_PUSH, screen);
+}
+
+void Game::popScreen() {
+    requestScreenChange(SCREEN_CHANGE_POP, NULL);
+}
+
+void Game::waitForScreenPreloads() {
+    for(unsigned int i = 0; i < screenChanges.size(); i++) {
+        if(screenChanges[i].preloading != NULL) jobs->wait(screenChanges[i].preloading);
+    }
+}
+
+bool Game::postEvent(const GameEvent &event) {
+    return events.push(event);
+}
+
+void Game::handleEvents() {
+    //Only a queue's worth, events posted while handling these wait for the next update
+    events.drain([this](const GameEvent &event) {
+        for (unsigned int i = 0; i < screens.size(); i++) screens[i]->handleEvent(this, event);
+    }, events.capacity());
 }
 
 bool Game::isRunning() const {
@@ -163,45 +516,242 @@ Window * Game::getWindow() const {
     return window;
 }
 
-void Game::loadSpriteSheet(const char *path) {
-	std::string fileName = FileUtil::getFileName(path);
-	if (spriteSheets.find(fileName) != spriteSheets.end()) return;
-    spriteSheets.insert(std::pair<std::string, SpriteSheet *>(fileName, new SpriteSheet(window->getWindowRenderer(), path)));
+BaseScreen * Game::getCurrentScreen() const {
+    return currentScreen;
+}
+
+JobSystem * Game::getJobs() const {
+    return jobs;
+}
+
+TimerWheel * Game::getTimers() const {
+    return timers;
+}
+
+void Game::runHeadless(unsigned int steps) {
+    runHeadless([steps](Game *game) { game->stepHeadless(steps); });
+}
+
+void Game::runHeadless(const std::function<void(Game *)> &run) {
+    headless = true;
+    init();
+
+    //Straight to the world, there is no loading screen and nothing waits for a frame
+    if(inputReplay != NULL) inputReplay->nextScreen();
+    requestNewScreen(new WorldScreen());
+    waitForScreenPreloads();
+    changeScreens();
+
+    run(this);
+    running = false;
+    deinit();
 }
 
-SpriteSheet * Game::getSpriteSheet(const char *spriteSheetName) {
-    SpriteSheet *sheet = NULL;
-    std::string fileName(spriteSheetName);
-    std::map<std::string, SpriteSheet *>::const_iterator iterator = spriteSheets.find(fileName);
-    if(iterator != spriteSheets.end()) {
-        sheet = iterator->second;
+void Game::stepHeadless(unsigned int steps) {
+    //Background ticks keep the same rate in steps as they would have in real time
+    unsigned int backgroundEvery = Constants::GAME_BACKGROUND_LOOP_DELAY * 1000 / Constants::GAME_TICK_MICROSECONDS;
+    if(backgroundEvery == 0) backgroundEvery = 1;
+
+    //Step as fast as possible, nothing is drawn unless a stress test wants to know what drawing costs
+    //Then a frame is drawn (to the dummy video driver) as often as it would have been in real time
+    unsigned int frameEvery = Constants::TARGET_TICKS_PER_SECOND / Constants::TARGET_FPS;
+    if(frameEvery == 0) frameEvery = 1;
+    Util::log(SDL_LOG_PRIORITY_INFO, "Running " + std::to_string(steps) + " steps headless");
+    SystemTimings::reset();
+    SystemTimings::setEnabled(true);
+    Clock::time_point start = Clock::now();
+    unsigned int ran = 0;
+    for(; ran < steps && running; ran++) {
+        jobs->runMainThreadJobs();
+        handleEvents();
+        step();
+        if((ran + 1) % backgroundEvery == 0) runBackgroundTicks();
+        changeScreens();
+        if(crowdStress != NULL && (ran + 1) % frameEvery == 0) drawFrame();
+        endAllocationFrame();
     }
+    std::chrono::nanoseconds elapsed = Clock::now() - start;
+    SystemTimings::setEnabled(false);
+
+    double seconds = elapsed.count() / 1e9;
+    Util::log(SDL_LOG_PRIORITY_INFO, "Ran " + std::to_string(ran) + " steps in " + std::to_string(seconds) + "s, "
+        + std::to_string(seconds > 0 ? static_cast<unsigned long long> (ran / seconds) : 0) + " steps per second");
+    SystemTimings::logReport(ran, static_cast<unsigned long long> (elapsed.count()));
+}
+
+void Game::recordInput(const char *path) {
+    if(inputRecorder == NULL) inputRecorder = new InputRecorder(path);
+}
+
+void Game::replayInput(const char *path) {
+    if(inputReplay == NULL) inputReplay = new InputReplay(path);
+}
+
+void Game::traceTo(const char *path) {
+    tracePath = path;
+}
+
+void Game::logRenderStats() {
+    renderStatsLogged = true;
+}
+
+void Game::stressTest(unsigned int npcs, const std::string &map, unsigned int seconds, const std::string &reportPath) {
+    if(crowdStress != NULL) delete crowdStress;
+    crowdStress = new CrowdStress(npcs, map, seconds, reportPath);
+    timingCosts = true;
+}
+
+CrowdStress * Game::getCrowdStress() const {
+    return crowdStress;
+}
+
+GameCosts Game::getCosts() const {
+    GameCosts costs;
+    costs.steps = stepsTimed.load(std::memory_order_relaxed);
+    costs.stepNanoseconds = stepNanosecondsTimed.load(std::memory_order_relaxed);
+    costs.frames = framesTimed.load(std::memory_order_relaxed);
+    costs.renderNanoseconds = renderNanosecondsTimed.load(std::memory_order_relaxed);
+    return costs;
+}
+
+bool Game::isHeadless() const {
+    return headless;
+}
+
+void Game::preloadSpriteSheets(const std::vector<std::string> &paths) {
+
+	//Only the images nobody has loaded or is loading yet, the screen change waits for the ones loading in the background
+	AllocationScope allocations(ALLOCATION_LOADER);
+	std::vector<std::string> wanted;
+	for (unsigned int i = 0; i < paths.size(); i++) {
+		std::string fileName = FileUtil::getFileName(paths[i].c_str());
+		spriteSheets.add(fileName, paths[i]);
+		bool load;
+		ResourceHandle<SpriteSheet> sheet = spriteSheets.acquire(AssetId(fileName), load);
+		if (load) wanted.push_back(paths[i]);
+	}
+
+	//Decode the images on every core, only the main thread can turn them into textures
+	std::vector<SDL_Surface *> images(wanted.size(), NULL);
+	jobs->parallelFor(wanted.size(), 1, [&wanted, &images](unsigned int begin, unsigned int end) {
+		AllocationScope allocations(ALLOCATION_LOADER);
+		for (unsigned int i = begin; i < end; i++) images[i] = IMG_Load(wanted[i].c_str());
+	});
+
+	SDL_LockMutex(assetLock);
+	for (unsigned int i = 0; i < wanted.size(); i++) {
+		preloadedImages.push_back(std::pair<std::string, SDL_Surface *>(wanted[i], images[i]));
+	}
+	SDL_UnlockMutex(assetLock);
+}
+
+void Game::loadSpriteSheetInBackground(const std::string &path) {
+	jobs->submit([this, path]() {
+		AllocationScope allocations(ALLOCATION_LOADER);
+		SDL_Surface *image = IMG_Load(path.c_str());
+		SDL_LockMutex(assetLock);
+		preloadedImages.push_back(std::pair<std::string, SDL_Surface *>(path, image));
+		SDL_UnlockMutex(assetLock);
+
+		//Counted on the same counter, the load is only done once the sheet is made
+		jobs->submitToMainThread([this]() { addPreloadedSpriteSheets(); }, &spriteSheetLoads);
+	}, &spriteSheetLoads);
+}
+
+void Game::addPreloadedSpriteSheets() {
+	AllocationScope allocations(ALLOCATION_LOADER);
+	SDL_LockMutex(assetLock);
+	if (!preloadedImages.empty()) assetsChanged = true;
+	for (unsigned int i = 0; i < preloadedImages.size(); i++) {
+		const std::string &path = preloadedImages[i].first;
+		std::string fileName = FileUtil::getFileName(path.c_str());
+		SpriteSheet *sheet = NULL;
+		if (preloadedImages[i].second != NULL) {
+			sheet = new SpriteSheet(window->getWindowRenderer(), preloadedImages[i].second, path.c_str());
+			SDL_FreeSurface(preloadedImages[i].second);
+		}
+		else {
+			Util::log(SDL_LOG_PRIORITY_ERROR, "Failed to load image: " + path + " (" + SDL_GetError() + ")");
+		}
+		spriteSheets.finishLoad(AssetId(fileName), sheet);
+	}
+	preloadedImages.clear();
+	SDL_UnlockMutex(assetLock);
+}
+
+void Game::evictUnusedResources() {
+	long long graceUs = static_cast<long long> (Constants::GAME_RESOURCE_GRACE_PERIOD) * 1000;
+	long long now = nowMicroseconds();
+	AllocationScope allocations(ALLOCATION_LOADER);
+	unsigned int evicted = spriteSheets.evictUnused(now, graceUs) + fonts.evictUnused(now, graceUs);
+	if (evicted > 0) {
+		assetsChanged = true;
+		Util::log(SDL_LOG_PRIORITY_INFO, "Unloaded " + std::to_string(evicted) + " unused assets, " 
+			+ std::to_string(spriteSheets.getLoadedCount()) + " sprite sheets and " 
+			+ std::to_string(fonts.getLoadedCount()) + " fonts are loaded");
+	}
+}
+
+ResourceHandle<SpriteSheet> Game::getSpriteSheet(const AssetId &id) {
+    bool load;
+    ResourceHandle<SpriteSheet> sheet = spriteSheets.acquire(id, load);
+    if(load) loadSpriteSheetInBackground(sheet.getPath());
     return sheet;
 }
 
-Font * Game::getFont(const char *fontName) {
-    Font *font = NULL;
-    std::string fileName(fontName);
-    std::map<std::string, Font *>::const_iterator iterator = fonts.find(fileName);
-    if(iterator != fonts.end()) {
-        font = iterator->second;
-    }
+ResourceHandle<Font> Game::getFont(const AssetId &id) {
+    //Opening the font file waits for the first text sprite, there is nothing to do in the background
+    bool load;
+    ResourceHandle<Font> font = fonts.acquire(id, load);
+    if(load) fonts.finishLoad(id, new Font(font.getPath().c_str()));
     return font;
 }
 
 void Game::deinit() {
+
+    if(AllocationTracker::isAvailable()) AllocationTracker::logReport();
+    if(!tracePath.empty()) {
+        Trace::setEnabled(false);
+        Trace::writeChromeTrace(tracePath.c_str());
+    }
+
+    //Stop the simulation first, nothing else is safe to tear down while it steps
+    if(simulationThread != NULL) {
+        int threadRetVal;
+        SDL_WaitThread(simulationThread, &threadRetVal);
+        simulationThread = NULL;
+    }
+    SDL_DestroyMutex(simulationLock);
+    simulationLock = NULL;
 	
-    //Stop the screen
-    if (currentScreen != NULL) {
-		currentScreen->stop(this);
-		delete currentScreen;
-		currentScreen = NULL;
+    //Let the jobs finish before anything they use goes away
+    jobs->waitIdle();
+
+    //Stop the screens, top down, the ones that never started only need deleting
+    while (!screens.empty()) {
+		screens.back()->stop(this);
+		delete screens.back();
+		screens.pop_back();
 	}
-    if (nextScreen != NULL) {
-		delete nextScreen;
-		nextScreen = NULL;
+    currentScreen = NULL;
+    visibleScreens.clear();
+    if(perfHud != NULL) {
+        delete perfHud;
+        perfHud = NULL;
+    }
+    for (unsigned int i = 0; i < screenChanges.size(); i++) {
+		delete screenChanges[i].screen;
+		delete screenChanges[i].preloading;
 	}
-    Util::log(SDL_LOG_PRIORITY_INFO, "Successfully stopped the current screen!");
+    screenChanges.clear();
+    Util::log(SDL_LOG_PRIORITY_INFO, "Successfully stopped the screens!");
+
+    //The stress test belongs to the game, it is taken off the tick list before the rest of it is destroyed
+    if(crowdStress != NULL) {
+        unschedule(crowdStress);
+        delete crowdStress;
+        crowdStress = NULL;
+    }
 
 	//All unregistered game objects will be destroyed here
 	for (unsigned int i = 0; i < updatables.size(); i++) {
@@ -211,27 +761,43 @@ void Game::deinit() {
 	}
 	updatables.clear();
     
-    //Stop background thread
-    int threadRetVal;
-    SDL_WaitThread(backgroundThread, &threadRetVal);
-    backgroundThread = NULL;
-    if(threadRetVal != 0) {
-        char val = '0' + threadRetVal;
-        std::string message = "Warning: Background thread returned with an invalid value of ";
-        message += val;
-        Util::log(SDL_LOG_PRIORITY_WARN, message);
+    //Stop the worker threads
+    delete jobs;
+    jobs = NULL;
+    Util::log(SDL_LOG_PRIORITY_INFO, "Successfully stopped the worker threads!");
+
+    //Finish the input recording
+    if(inputRecorder != NULL) {
+        delete inputRecorder;
+        inputRecorder = NULL;
+    }
+    if(inputReplay != NULL) {
+        delete inputReplay;
+        inputReplay = NULL;
     }
-    Util::log(SDL_LOG_PRIORITY_INFO, "Successfully stopped background thread!");
 
     //Free the timers
-    if(fpsTimer != NULL) {
-        delete fpsTimer;
-        fpsTimer = NULL;
+    if(frameScheduler != NULL) {
+        frameScheduler->logStatistics();
+        delete frameScheduler;
+        frameScheduler = NULL;
     }
 	if (tickTimer != NULL) {
 		delete tickTimer;
 		tickTimer = NULL;
 	}
+	if (backgroundTimer != NULL) {
+		delete backgroundTimer;
+		backgroundTimer = NULL;
+	}
+	if (resourceTimer != NULL) {
+		delete resourceTimer;
+		resourceTimer = NULL;
+	}
+	if (timers != NULL) {
+		delete timers;
+		timers = NULL;
+	}
 
     //Destroy the window
     if(window != NULL) {
@@ -244,20 +810,13 @@ void Game::deinit() {
     MapLoader::getInstance()->deleteInstance();
     Util::log(SDL_LOG_PRIORITY_INFO, "Successfully deleted maps and tilesets");
     
-    //Delete all of the fonts
-    for(std::map<std::string, Font *>::const_iterator iterator = fonts.begin(); iterator != fonts.end(); ++iterator) {
-        if(iterator->second != NULL) {
-            delete iterator->second;
-        }
-    }
-
-    //Delete all of the spritesheets
-    for(std::map<std::string, SpriteSheet *>::const_iterator iterator = spriteSheets.begin(); iterator != spriteSheets.end(); ++iterator) {
-        if(iterator->second != NULL) {
-            delete iterator->second;
-        }
-    }
+    //Delete all of the fonts and spritesheets, whatever held them is gone by now
+    fonts.clear();
     spriteSheets.clear();
+    for(unsigned int i = 0; i < preloadedImages.size(); i++) SDL_FreeSurface(preloadedImages[i].second);
+    preloadedImages.clear();
+    SDL_DestroyMutex(assetLock);
+    assetLock = NULL;
     Util::log(SDL_LOG_PRIORITY_INFO, "Successfully deleted sprites and fonts!");
 
 	//Deinit SDL
@@ -267,12 +826,3 @@ void Game::deinit() {
 }
 
 void Game::quit() { running = false; }
-
-int runInBackgroundThread(void *gahoodmon) {
-    Game *game = static_cast<Game *> (gahoodmon);
-    while(game->isRunning()) {
-        game->runInBackground();
-        Util::sleep(Constants::GAME_BACKGROUND_LOOP_DELAY);
-    }
-    return 0;
-}
@@ -2,16 +2,37 @@
 #define GAHOODMON_HPP
 
 #include <vector>
-#include <map>
 #include <string>
+#include <atomic>
+#include <functional>
 #include "Window.hpp"
+#include "GameEvent.hpp"
+#include "InputFrame.hpp"
+#include "../util/SlotMap.hpp"
+#include "../util/JobSystem.hpp"
+#include "../util/SpscQueue.hpp"
+#include "../util/ResourceHandle.hpp"
 
-struct SDL_Thread;
 class Timer;
+class TimerWheel;
+class FrameScheduler;
 class SpriteSheet;
 class BaseScreen;
 class Font;
 class BaseGameObject;
+class InputRecorder;
+class InputReplay;
+class PerfHud;
+class CrowdStress;
+struct SDL_Thread;
+struct SDL_mutex;
+struct SDL_Surface;
+
+//What the simulation steps and the frames drawn have cost so far, added up only while something is timing them
+typedef struct GameCosts {
+    unsigned long long steps, stepNanoseconds;
+    unsigned long long frames, renderNanoseconds;
+} GameCosts;
 
 class Game {
 public:
@@ -20,51 +41,195 @@ public:
 
     /* NEVER CALL THESE FUNCTIONS */
     void run();
-    void runInBackground();
-    void loadSpriteSheet(const char *path);
+    void runHeadless(unsigned int steps);
     /* ************************** */
 
+    //Start the world headless (software renderer, nothing shown) and hand the game over to run,
+    //the game shuts down once run returns, for tools like the benchmarks
+    void runHeadless(const std::function<void(Game *)> &run);
+
+    //Call before run, record the keyboard to a file or play a recording back instead of the keyboard
+    //The game quits when the recording is over
+    void recordInput(const char *path);
+    void replayInput(const char *path);
+
+    //Call before run, trace the game (builds with GAME_TRACING) and save the trace to a file when the game closes
+    //or when F12 is pressed, open it in chrome://tracing or Perfetto
+    void traceTo(const char *path);
+
+    //Call before run, log a summary of what the window drew every Constants::WINDOW_RENDER_STATS_FRAMES frames
+    void logRenderStats();
+
+    //Call before run, fill the world with npcs walking around at random for a while, then report what they cost and quit
+    //An empty map keeps the map the world starts on, the report is added to reportPath as a line of CSV (unless it's empty)
+    void stressTest(unsigned int npcs, const std::string &map, unsigned int seconds, const std::string &reportPath);
+
+    //The stress test asked for, NULL when the game runs normally
+    CrowdStress * getCrowdStress() const;
+
+    //From any thread, what the steps and frames cost while the performance HUD or a stress test has been timing them
+    GameCosts getCosts() const;
+
+    bool isHeadless() const;
+
     //Tells if the game is running or not
     bool isRunning() const;
 
-    //Quit the game, begins the cleanup process before shutting down
+    //Quit the game from any thread, begins the cleanup process before shutting down
     void quit();
 
-    //Request a screen change
+    /* Screen changes, the game owns the screens from here on
+     * Every change waits for its screen to preload, the changes happen in the order they were asked for
+     * Call these on the simulation thread (ie: from a tick or while handling input) or in a main thread job */
+
+    //Replace the screen on top of the stack
     void requestNewScreen(BaseScreen *newScreen);
 
+    //Pause the screen on top and put a new one over it (ie: a battle or a menu over the world)
+    void pushScreen(BaseScreen *newScreen);
+
+    //Stop the screen on top and resume the one under it, popping the last screen quits the game
+    void popScreen();
+
+    //Decode images on the calling thread (any thread, ie: in a screen's preload), it never waits for the main thread
+    //They become sprite sheets on the main thread before the next screen starts, images already loaded are skipped
+    //and the screen change also waits for the ones already loading in the background
+    void preloadSpriteSheets(const std::vector<std::string> &paths);
+
+    //Post an event from any thread, every screen on the stack handles it on the main thread during the next update
+    //Returns false if too many events are waiting already
+    bool postEvent(const GameEvent &event);
+
     //Add a game object to the game to be scheduled to tick
+    //Objects scheduled during a tick start ticking on the next one
 	void schedule(BaseGameObject *obj);
 
-    //Remove a game object from the object tick list
+    //Remove a game object from the object tick list, it stops ticking straight away
 	void unschedule(BaseGameObject *obj);
 
+    //Get the timer wheel, it moves forward one tick every simulation step
+    TimerWheel * getTimers() const;
+
     //Get the game window
     Window * getWindow() const;
 
-    //Get a sprite sheet to make a sprite
-    SpriteSheet * getSpriteSheet(const char *spriteSheetName);
+    //Get the screen on top of the stack, NULL before the first screen starts
+    BaseScreen * getCurrentScreen() const;
+
+    //Get the worker threads to run jobs on
+    JobSystem * getJobs() const;
+
+    /* Assets, by the id of their file name (ie: "NPC 01.png"_asset), from any thread
+     * Hold on to the handle for as long as anything made from the asset is around (sprites, textures, text),
+     * assets no handle has held for Constants::GAME_RESOURCE_GRACE_PERIOD are unloaded
+     * The grace period also covers the snapshots still pointing at an asset after its last handle went away */
+
+    //Get a sprite sheet to make a sprite, a sheet that isn't loaded is decoded in the background and stays pending until then
+    ResourceHandle<SpriteSheet> getSpriteSheet(const AssetId &spriteSheet);
     
-    //Get a font to make a text sprite
-    Font * getFont(const char *fontName);
+    //Get a font to make a text sprite, fonts load straight away
+    ResourceHandle<Font> getFont(const AssetId &font);
 
 private:
     //Member variables//
-    bool running;
+    std::atomic<bool> running;
+    bool headless;
     Window *window;
-    Timer *fpsTimer, *tickTimer;
-    SDL_Thread *backgroundThread;
-    BaseScreen *currentScreen, *nextScreen;
+    Timer *tickTimer;
+    FrameScheduler *frameScheduler;
+    unsigned int tickAccumulator;
+    JobSystem *jobs;
+    Timer *backgroundTimer;
+    JobCounter backgroundTicks;
+
+    /* The screen stack, only the screen on top (currentScreen) runs, the others are paused
+     * The screens drawn are the top one and the ones under it down to the first that isn't an overlay */
+    typedef enum ScreenChangeType {
+        SCREEN_CHANGE_REPLACE,
+        SCREEN_CHANGE_PUSH,
+        SCREEN_CHANGE_POP
+    } ScreenChangeType;
+    typedef struct ScreenChange {
+        ScreenChangeType type;
+        BaseScreen *screen;
+        JobCounter *preloading;
+    } ScreenChange;
+    std::vector<BaseScreen *> screens, visibleScreens;
+    BaseScreen *currentScreen;
+    std::vector<ScreenChange> screenChanges;
+
+    /* The simulation runs on its own thread (unless GAME_SIMULATION_THREAD is off),
+     * it holds the lock for as long as it is stepping, the main thread takes it
+     * to change screens and to handle jobs and events */
+    SDL_Thread *simulationThread;
+    SDL_mutex *simulationLock;
+    SpscQueue<InputFrame> input;
+    InputFrame pendingInput;
+    uint8_t stepKeys[SDL_NUM_SCANCODES];
+    InputRecorder *inputRecorder;
+    InputReplay *inputReplay;
+    std::atomic<long long> lastStepUs;
+    std::string tracePath;
+    bool renderStatsLogged;
+
+    /* The performance overlay (F3), drawn over the visible screens while it is shown
+     * The simulation adds up how many steps it ran and how long they took, the main thread collects that every frame */
+    PerfHud *perfHud;
+    std::atomic<bool> perfHudShown;
+    long long lastFrameUs;
+    unsigned int scheduledObjects;
+    GameCosts hudCosts;
+
+    //Timing the steps and the frames costs two clock reads each, it is only done when someone wants the costs
+    CrowdStress *crowdStress;
+    std::atomic<bool> timingCosts;
+    std::atomic<unsigned long long> stepsTimed, stepNanosecondsTimed, framesTimed, renderNanosecondsTimed;
 
     //Member functions//
     void init();
     void update();
     void deinit();
     void changeScreens();
+    void requestScreenChange(ScreenChangeType type, BaseScreen *screen);
+    void applyScreenChange(const ScreenChange &change);
+    void waitForScreenPreloads();
+    void addPreloadedSpriteSheets();
+    void loadSpriteSheetInBackground(const std::string &path);
+    void evictUnusedResources();
+    void endAllocationFrame();
+    void togglePerfHud();
+    void samplePerformance();
+    void drawFrame();
+    void stepHeadless(unsigned int steps);
+    void handleEvents();
+    void pollInput();
+    void simulate();
+    void step();
+    void runBackgroundTicks();
+    void handleStepInput();
+    float getStepProgress() const;
+    unsigned int getMicrosecondsUntilNextTick();
+    unsigned int getMicrosecondsUntilNextStep() const;
+    static int runSimulation(void *data);
+    void tickObject(BaseGameObject *obj);
+    void armObject(BaseGameObject *obj, unsigned int delayMicroseconds);
+    void tickInBackground();
+
+    TimerWheel *timers;
+	SlotMap<BaseGameObject *> updatables;
+    MpscQueue<GameEvent> events;
+    ResourceRegistry<SpriteSheet> spriteSheets;
+    ResourceRegistry<Font> fonts;
+    Timer *resourceTimer;
+    JobCounter spriteSheetLoads;
+
+    //Frames (or headless steps) that can't allocate without it being a problem are the steady state ones
+    unsigned int framesSinceScreenChange;
+    bool assetsChanged;
 
-	std::vector<BaseGameObject *> updatables;
-    std::map<std::string, SpriteSheet *> spriteSheets;
-    std::map<std::string, Font *> fonts;
+    //Images decoded in the background, waiting for the main thread to make them into sprite sheets (NULL if decoding failed)
+    SDL_mutex *assetLock;
+    std::vector<std::pair<std::string, SDL_Surface *> > preloadedImages;
 };
 
 #endif
@@ -0,0 +1,28 @@
+#ifndef GAME_EVENT_HPP
+#define GAME_EVENT_HPP
+
+typedef enum GameEventType { 
+	GAME_EVENT_ASSET_READY, 
+	GAME_EVENT_PATH_FOUND, 
+	GAME_EVENT_TILE_CHANGED, 
+	GAME_EVENT_PLAY_SOUND 
+} GameEventType;
+
+/**
+ * A message posted from any thread, handled by the current screen on the main thread
+ * Small and copyable so it can go straight into a queue slot
+ */
+typedef struct GameEvent {
+	GameEventType type;
+
+	//Tile the event is about (tile changed, path found)
+	int tileX, tileY;
+
+	//New tile id, path length...
+	int value;
+
+	//Asset or sound name, has to outlive the event (ie: a constant)
+	const char *name;
+} GameEvent;
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef INPUT_FRAME_HPP
+#define INPUT_FRAME_HPP
+
+#include <stdint.h>
+#include <SDL2/SDL_events.h>
+#include <SDL2/SDL_scancode.h>
+
+/**
+ * The input the main thread polled since the last frame it handed to the simulation:
+ * the window events and the keyboard state at the end
+ */
+typedef struct InputFrame {
+	//Events after the first MAX_EVENTS of a frame are dropped
+	static const unsigned int MAX_EVENTS = 16;
+
+	SDL_Event events[MAX_EVENTS];
+	unsigned int eventCount;
+	uint8_t keys[SDL_NUM_SCANCODES];
+} InputFrame;
+
+#endif
@@ -0,0 +1,138 @@
+#include "InputRecording.hpp"
+
+#include <cstring>
+#include <SDL2/SDL.h>
+#include "../util/Util.hpp"
+
+static const char MAGIC[4] = { 'G', 'H', 'I', 'R' };
+static const uint8_t VERSION = 1;
+static const unsigned int HEADER_SIZE = sizeof(MAGIC) + 3;
+
+//What an entry is for, anything from KEYS up is a number of keys that changed plus KEYS
+static const unsigned int NEW_SCREEN = 0, END = 1, KEYS = 2;
+
+//7 bits at a time, the top bit says another byte follows
+static void appendNumber(std::vector<uint8_t> &bytes, unsigned int value) {
+	while (value >= 0x80) {
+		bytes.push_back(static_cast<uint8_t> (value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<uint8_t> (value));
+}
+
+InputRecorder::InputRecorder(const char *path) : file(SDL_RWFromFile(path, "wb")), steps(0) {
+	if (file == NULL) Util::fatalSDLError("Failed to create the input recording");
+	memset(keys, 0, sizeof(keys));
+	uint8_t header[HEADER_SIZE];
+	memcpy(header, MAGIC, sizeof(MAGIC));
+	header[4] = VERSION;
+	header[5] = static_cast<uint8_t> (SDL_NUM_SCANCODES & 0xFF);
+	header[6] = static_cast<uint8_t> (SDL_NUM_SCANCODES >> 8);
+	if (SDL_RWwrite(file, header, 1, HEADER_SIZE) != HEADER_SIZE) Util::fatalSDLError("Failed to write the input recording");
+}
+
+InputRecorder::~InputRecorder() {
+	writeEntry(END);
+	SDL_RWclose(file);
+	file = NULL;
+}
+
+void InputRecorder::record(const uint8_t *newKeys) {
+	changed.clear();
+	for (unsigned int i = 0; i < SDL_NUM_SCANCODES; i++) {
+		uint8_t down = newKeys[i] != 0 ? 1 : 0;
+		if (down == keys[i]) continue;
+		keys[i] = down;
+		changed.push_back(i);
+	}
+	if (!changed.empty()) writeEntry(KEYS + static_cast<unsigned int> (changed.size()));
+	steps++;
+}
+
+void InputRecorder::nextScreen() {
+	changed.clear();
+	writeEntry(NEW_SCREEN);
+}
+
+void InputRecorder::writeEntry(unsigned int what) {
+	entry.clear();
+	appendNumber(entry, steps);
+	appendNumber(entry, what);
+	for (unsigned int i = 0; i < changed.size(); i++) appendNumber(entry, changed[i]);
+	if (SDL_RWwrite(file, &entry[0], 1, entry.size()) != entry.size()) Util::fatalSDLError("Failed to write the input recording");
+	steps = 0;
+}
+
+InputReplay::InputReplay(const char *path) : position(HEADER_SIZE), steps(0), nextSteps(0), nextWhat(END), finished(false) {
+	SDL_RWops *file = SDL_RWFromFile(path, "rb");
+	if (file == NULL) Util::fatalSDLError("Failed to open the input recording");
+	Sint64 size = SDL_RWsize(file);
+	if (size > 0) data.resize(static_cast<size_t> (size));
+	if (size <= 0 || SDL_RWread(file, &data[0], 1, data.size()) != data.size()) Util::fatalSDLError("Failed to read the input recording");
+	SDL_RWclose(file);
+
+	//Recorded with a different SDL would have different scancodes
+	if (data.size() < HEADER_SIZE || memcmp(&data[0], MAGIC, sizeof(MAGIC)) != 0 || data[4] != VERSION
+		|| (data[5] | (data[6] << 8)) != SDL_NUM_SCANCODES) {
+		Util::fatalError("Not an input recording this game can play");
+	}
+	memset(keys, 0, sizeof(keys));
+	readEntry();
+}
+
+InputReplay::~InputReplay() {}
+
+bool InputReplay::play(uint8_t *out) {
+	if (finished) return false;
+	while (nextWhat >= KEYS && nextSteps == steps) applyEntry();
+	if (nextWhat == END && nextSteps == steps) {
+		finished = true;
+		return false;
+	}
+
+	//A new screen that is due now waits for the screen to actually change, the keys stay as they are
+	memcpy(out, keys, sizeof(keys));
+	steps++;
+	return true;
+}
+
+void InputReplay::nextScreen() {
+	//Normally the new screen is the very next entry, anything before it still belonged to the old screen
+	while (!finished && nextWhat != NEW_SCREEN) {
+		if (nextWhat == END) finished = true;
+		else applyEntry();
+	}
+	if (finished) return;
+	steps = 0;
+	readEntry();
+}
+
+bool InputReplay::isFinished() const { return finished; }
+
+bool InputReplay::readNumber(unsigned int &value) {
+	value = 0;
+	for (unsigned int shift = 0; position < data.size() && shift < 32; shift += 7) {
+		uint8_t byte = data[position++];
+		value |= static_cast<unsigned int> (byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) return true;
+	}
+	return false;
+}
+
+void InputReplay::readEntry() {
+	//A cut off recording ends where it was cut off
+	if (!readNumber(nextSteps) || !readNumber(nextWhat)) {
+		nextSteps = steps;
+		nextWhat = END;
+	}
+}
+
+void InputReplay::applyEntry() {
+	for (unsigned int i = KEYS; i < nextWhat; i++) {
+		unsigned int scancode;
+		if (!readNumber(scancode)) break;
+		if (scancode < SDL_NUM_SCANCODES) keys[scancode] = keys[scancode] ? 0 : 1;
+	}
+	steps = 0;
+	readEntry();
+}
@@ -0,0 +1,67 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+/**
+ * Input recordings, the keyboard state the simulation saw on every step
+ * Only changes are kept: how many steps since the last change and which keys went down or up
+ * Every screen gets its own part of the recording counted from the step it started on,
+ * so a replay lines up again however long loading took
+ *
+ * The file is a header followed by entries of variable length numbers:
+ * steps since the last entry, then what happened, 0 for a new screen, 1 for the end of the recording
+ * or the number of keys that changed plus 2 followed by their scancodes
+ */
+
+#include <stdint.h>
+#include <vector>
+#include <SDL2/SDL_scancode.h>
+
+struct SDL_RWops;
+
+class InputRecorder {
+public:
+	InputRecorder(const char *path);
+	~InputRecorder();
+
+	//The keys for the next step
+	void record(const uint8_t *keys);
+
+	//A new screen started, the next step is its first
+	void nextScreen();
+
+private:
+	SDL_RWops *file;
+	uint8_t keys[SDL_NUM_SCANCODES];
+	unsigned int steps;
+	std::vector<unsigned int> changed;
+	std::vector<uint8_t> entry;
+
+	void writeEntry(unsigned int what);
+};
+
+class InputReplay {
+public:
+	InputReplay(const char *path);
+	~InputReplay();
+
+	//Fill in the keys for the next step, false once the recording is over
+	bool play(uint8_t *keys);
+
+	//A new screen started, skip to its part of the recording
+	void nextScreen();
+
+	bool isFinished() const;
+
+private:
+	std::vector<uint8_t> data;
+	size_t position;
+	uint8_t keys[SDL_NUM_SCANCODES];
+	unsigned int steps, nextSteps, nextWhat;
+	bool finished;
+
+	bool readNumber(unsigned int &value);
+	void readEntry();
+	void applyEntry();
+};
+
+#endif
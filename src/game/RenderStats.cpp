@@ -0,0 +1,63 @@
+#include "RenderStats.hpp"
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+#include <SDL2/SDL_log.h>
+#include "../util/Util.hpp"
+
+static const char * const COUNTER_NAMES[RENDER_COUNTER_COUNT] = {
+	"copies",
+	"target switches",
+	"texture changes",
+	"clears",
+	"pixels filled"
+};
+
+RenderStats::RenderStats(unsigned int frames) : current(), lastFrame(), history(frames > 0 ? frames : 1),
+	next(0), recorded(0), frames(0), logging(false), sorted(history.size()) {}
+
+void RenderStats::endFrame() {
+	lastFrame = current;
+	current = FrameRenderCounts();
+	history[next] = lastFrame;
+	next = (next + 1) % history.size();
+	if (recorded < history.size()) recorded++;
+	frames++;
+	if (logging && frames % history.size() == 0) logReport();
+}
+
+void RenderStats::setLogging(bool log) { logging = log; }
+
+const FrameRenderCounts & RenderStats::getLastFrame() const { return lastFrame; }
+
+unsigned int RenderStats::getFrameCount() const { return recorded; }
+
+RenderCounterSummary RenderStats::summarize(RenderCounter counter) const {
+	RenderCounterSummary summary = {};
+	if (recorded == 0) return summary;
+	unsigned long long total = 0;
+	for (unsigned int i = 0; i < recorded; i++) {
+		sorted[i] = history[i].counts[counter];
+		total += sorted[i];
+	}
+	std::sort(sorted.begin(), sorted.begin() + recorded);
+	summary.min = sorted[0];
+	summary.max = sorted[recorded - 1];
+	summary.p99 = sorted[(recorded - 1) * 99 / 100];
+	summary.average = static_cast<double> (total) / recorded;
+	return summary;
+}
+
+void RenderStats::logReport() const {
+	std::string message = "Render stats over the last " + std::to_string(recorded) + " frames (min / avg / p99 / max):";
+	char line[160];
+	for (unsigned int i = 0; i < RENDER_COUNTER_COUNT; i++) {
+		RenderCounterSummary summary = summarize(static_cast<RenderCounter> (i));
+		snprintf(line, sizeof(line), "\n  %-16s %10llu / %12.1f / %10llu / %10llu",
+			COUNTER_NAMES[i], summary.min, summary.average, summary.p99, summary.max);
+		message += line;
+	}
+	Util::log(SDL_LOG_PRIORITY_INFO, message);
+}
+
+const char * RenderStats::getName(RenderCounter counter) { return COUNTER_NAMES[counter]; }
@@ -0,0 +1,66 @@
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+
+/**
+ * Counts what the window asks the renderer to do, frame by frame
+ * The last Constants::WINDOW_RENDER_STATS_FRAMES frames drawn are kept to summarize (min, average, p99, max)
+ * Frames skipped because nothing changed aren't recorded, anything drawn between two frames (ie: text textures
+ * made while loading) counts towards the next frame drawn
+ * Main thread only, like the window
+ */
+
+#include <vector>
+
+typedef enum RenderCounter {
+	RENDER_COPIES,
+	RENDER_TARGET_SWITCHES,
+	RENDER_TEXTURE_CHANGES,
+	RENDER_CLEARS,
+	//Pixels copies, clears and fills asked for, before clipping
+	RENDER_PIXELS_FILLED,
+	RENDER_COUNTER_COUNT
+} RenderCounter;
+
+typedef struct FrameRenderCounts {
+	unsigned long long counts[RENDER_COUNTER_COUNT];
+} FrameRenderCounts;
+
+typedef struct RenderCounterSummary {
+	unsigned long long min, p99, max;
+	double average;
+} RenderCounterSummary;
+
+class RenderStats {
+public:
+	RenderStats(unsigned int frames);
+
+	void count(RenderCounter counter, unsigned long long amount = 1) { current.counts[counter] += amount; }
+
+	//Once a frame is presented, logs the summary every time the whole history has been filled again when logging
+	void endFrame();
+
+	void setLogging(bool log);
+
+	//What the last frame drawn did
+	const FrameRenderCounts & getLastFrame() const;
+
+	//Over the frames kept (getFrameCount of them), all zero before the first frame
+	RenderCounterSummary summarize(RenderCounter counter) const;
+	unsigned int getFrameCount() const;
+
+	void logReport() const;
+
+	static const char * getName(RenderCounter counter);
+
+private:
+	FrameRenderCounts current, lastFrame;
+	std::vector<FrameRenderCounts> history;
+	unsigned int next, recorded;
+	unsigned long long frames;
+	bool logging;
+
+	//Reused to sort a counter's history, so summarizing doesn't allocate
+	mutable std::vector<unsigned long long> sorted;
+};
+
+#endif
@@ -6,9 +6,15 @@
 #include "../util/Constants.hpp"
 #include "../util/Util.hpp"
 #include "../util/DisplayUtil.hpp"
+#include "../util/AllocationTracker.hpp"
+#include "../util/Trace.hpp"
 #include "../screen/BaseScreen.hpp"
 
-Window::Window() {
+std::atomic<unsigned long long> Window::textureBytes(0);
+
+Window::Window(bool headless) : dirty(true), interpolation(1.0f), cameraSet(false), 
+	stats(Constants::WINDOW_RENDER_STATS_FRAMES), lastTexture(NULL), currentTarget(NULL), 
+	targetWidth(Constants::WINDOW_WIDTH), targetHeight(Constants::WINDOW_HEIGHT) {
     
     //Create the window
 	SDL_Surface *gameIcon = IMG_Load(Constants::GAME_ICON);
@@ -17,8 +23,8 @@ Window::Window() {
 		DisplayUtil::getScreenWidth() / 2 - Constants::WINDOW_WIDTH / 2,
 		DisplayUtil::getScreenHeight() / 2 - Constants::WINDOW_HEIGHT / 2, 
 		Constants::WINDOW_WIDTH, 
-		Constants::WINDOW_HEIGHT, Constants
-		::WINDOW_FLAGS);
+		Constants::WINDOW_HEIGHT, 
+		headless ? SDL_WINDOW_HIDDEN : Constants::WINDOW_FLAGS);
     if(win == NULL) {
         Util::fatalSDLError("Failed to initialize the window");
     }
@@ -27,7 +33,10 @@ Window::Window() {
 	SDL_FreeSurface(gameIcon);
 
     //Create the renderer
-    winRenderer = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+    if(headless) rendererFlags = SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE;
+    else if(Constants::GAME_VSYNC) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    winRenderer = SDL_CreateRenderer(win, -1, rendererFlags);
     if(winRenderer == NULL) {
         Util::fatalSDLError("Failed to initialize the window renderer");
     }
@@ -55,41 +64,121 @@ Window::~Window() {
     }
 }
 
-void Window::render(BaseScreen *screen) {
-    if(SDL_RenderClear(winRenderer) < 0) {
-        Util::fatalSDLError("Failed to clear the texture renderer");
-    }
+bool Window::render(const std::vector<BaseScreen *> &screens) {
+    //Nothing changed since the last present, the window still shows the last frame
+    bool screensDirty = false;
+    for(unsigned int i = 0; i < screens.size() && !screensDirty; i++) screensDirty = screens[i]->isDirty();
+    if(!dirty && !screensDirty) return false;
+    TRACE_SCOPE("Window::render");
+    AllocationScope allocations(ALLOCATION_RENDER);
 
-    //Draw the screen to the texture here
-	if (screen != NULL) {
-		screen->render(this);
+    //Clear the damage before drawing so changes made while drawing schedule another frame
+    dirty = false;
+    for(unsigned int i = 0; i < screens.size(); i++) screens[i]->clearDirty();
+
+    clearRenderTarget();
+
+    //Draw the screens to the texture here
+	for (unsigned int i = 0; i < screens.size(); i++) {
+		screens[i]->render(this);
 	}
 
     SDL_RenderPresent(winRenderer);
+    stats.endFrame();
+    return true;
 }
 
+const RenderStats & Window::getRenderStats() const { return stats; }
+void Window::setLogRenderStats(bool log) { stats.setLogging(log); }
+
+void Window::invalidate() { dirty = true; }
+
+void Window::setInterpolation(float stepProgress) { interpolation = stepProgress; }
+float Window::getInterpolation() const { return interpolation; }
+
 void Window::setRenderTarget(SDL_Texture *targetTexture) const {
 	if (SDL_SetRenderTarget(winRenderer, targetTexture) < 0) {
 		Util::fatalSDLError("Failed to switch renderer to texture");
 	}
+	switchTarget(targetTexture);
 }
 
 void Window::resetRenderTarget() const {
 	if (SDL_SetRenderTarget(winRenderer, NULL) < 0) {
 		Util::fatalSDLError("Failed to switch renderer to texture");
 	}
+	switchTarget(NULL);
 }
 
-void Window::drawTexture(SDL_Texture *texture, SDL_Rect *srcRect, SDL_Rect *dstRect) const {
+void Window::switchTarget(SDL_Texture *targetTexture) const {
+	stats.count(RENDER_TARGET_SWITCHES);
+	currentTarget = targetTexture;
+	targetWidth = Constants::WINDOW_WIDTH;
+	targetHeight = Constants::WINDOW_HEIGHT;
+	if (targetTexture != NULL) SDL_QueryTexture(targetTexture, NULL, NULL, &targetWidth, &targetHeight);
+}
+
+void Window::drawTexture(SDL_Texture *texture, const SDL_Rect *srcRect, const SDL_Rect *dstRect) const {
+	SDL_Rect windowRect;
+	if (cameraSet && dstRect != NULL) {
+		windowRect = toWindowRect(*dstRect);
+		dstRect = &windowRect;
+	}
 	if (SDL_RenderCopy(winRenderer, texture, srcRect, dstRect) < 0) {
 		Util::fatalSDLError("Failed to draw the texure to window");
 	}
+	stats.count(RENDER_COPIES);
+	if (texture != lastTexture) stats.count(RENDER_TEXTURE_CHANGES);
+	lastTexture = texture;
+	stats.count(RENDER_PIXELS_FILLED, dstRect != NULL ? static_cast<unsigned long long> (dstRect->w) * dstRect->h 
+		: static_cast<unsigned long long> (targetWidth) * targetHeight);
+}
+
+void Window::setCamera(const SDL_Rect &view) {
+	camera = view;
+	cameraSet = view.w > 0 && view.h > 0;
+}
+
+void Window::resetCamera() { cameraSet = false; }
+
+/**
+ * Scale a rect from camera space to window space
+ * Edges are scaled instead of sizes so neighbouring rects never leave gaps
+ */
+static int scaleEdge(int offset, int windowSize, int viewSize) {
+	int scaled = offset * windowSize;
+	//Round towards negative infinity so edges left of the camera line up too
+	return scaled >= 0 ? scaled / viewSize : -((-scaled + viewSize - 1) / viewSize);
+}
+
+SDL_Rect Window::toWindowRect(const SDL_Rect &worldRect) const {
+	int left = scaleEdge(worldRect.x - camera.x, Constants::WINDOW_WIDTH, camera.w);
+	int top = scaleEdge(worldRect.y - camera.y, Constants::WINDOW_HEIGHT, camera.h);
+	int right = scaleEdge(worldRect.x + worldRect.w - camera.x, Constants::WINDOW_WIDTH, camera.w);
+	int bottom = scaleEdge(worldRect.y + worldRect.h - camera.y, Constants::WINDOW_HEIGHT, camera.h);
+	return Util::createRect(left, top, right - left, bottom - top);
 }
 
 void Window::clearRenderTarget() const {
     if(SDL_RenderClear(winRenderer) < 0) {
         Util::fatalSDLError("Failed to clear the window");
     }
+    stats.count(RENDER_CLEARS);
+    stats.count(RENDER_PIXELS_FILLED, static_cast<unsigned long long> (targetWidth) * targetHeight);
+}
+
+void Window::eraseRect(const SDL_Rect &rect, bool transparent) const {
+	//The draw blend mode is left at none, so the fill replaces the pixels
+	if (transparent && SDL_SetRenderDrawColor(winRenderer, 0, 0, 0, Constants::SPRITE_ALPHA_NONE) != 0) {
+		Util::fatalSDLError("Failed to change render draw color");
+	}
+	if (SDL_RenderFillRect(winRenderer, &rect) != 0) {
+		Util::fatalSDLError("Failed to erase the render target");
+	}
+	stats.count(RENDER_PIXELS_FILLED, static_cast<unsigned long long> (rect.w) * rect.h);
+	if (transparent && SDL_SetRenderDrawColor(winRenderer, 0, 0, 0, Constants::SPRITE_ALPHA_FULL) != 0) {
+		Util::fatalSDLError("Failed to reset render color");
+	}
 }
 
 SDL_Texture * Window::createTransparentTexture(int width, int height) const { 
@@ -99,6 +188,7 @@ SDL_Texture * Window::createTransparentTexture(int width, int height) const {
 		width,
 		height);
 	if (texture == NULL) Util::fatalSDLError("Failed to create transparent texture");
+	countTexture(texture);
 	setRenderTarget(texture);
 	if (SDL_SetRenderDrawBlendMode(winRenderer, SDL_BLENDMODE_BLEND) != 0) {
 		Util::fatalSDLError("Failed to change render blend mode");
@@ -112,6 +202,7 @@ SDL_Texture * Window::createTransparentTexture(int width, int height) const {
 	if (SDL_RenderFillRect(winRenderer, NULL) != 0) {
 		Util::fatalSDLError("Failed to fill transparent texture");
 	}
+	stats.count(RENDER_PIXELS_FILLED, static_cast<unsigned long long> (width) * height);
 	resetRenderTarget();
 	if (SDL_SetRenderDrawBlendMode(winRenderer, SDL_BLENDMODE_NONE) != 0) {
 		Util::fatalSDLError("Failed to change render blend mode back");
@@ -128,11 +219,46 @@ SDL_Texture * Window::createTexture(int width, int height) const {
 		SDL_TEXTUREACCESS_TARGET, 
 		width, 
 		height);
+	if (texture == NULL) Util::fatalSDLError("Failed to create texture");
+	countTexture(texture);
 	setRenderTarget(texture);
 	clearRenderTarget();
 	resetRenderTarget();
 	return texture;
 }
 
+void Window::fillRects(const SDL_Rect *rects, int count, const SDL_Color &color) const {
+	if (count <= 0) return;
+	if (SDL_SetRenderDrawColor(winRenderer, color.r, color.g, color.b, color.a) != 0) {
+		Util::fatalSDLError("Failed to change render draw color");
+	}
+	if (SDL_RenderFillRects(winRenderer, rects, count) != 0) {
+		Util::fatalSDLError("Failed to fill the rects");
+	}
+	if (SDL_SetRenderDrawColor(winRenderer, 0, 0, 0, Constants::SPRITE_ALPHA_FULL) != 0) {
+		Util::fatalSDLError("Failed to reset render color");
+	}
+	for (int i = 0; i < count; i++) stats.count(RENDER_PIXELS_FILLED, static_cast<unsigned long long> (rects[i].w) * rects[i].h);
+}
+
+static unsigned long long getTextureSize(SDL_Texture *texture) {
+	int width = 0, height = 0;
+	if (texture == NULL || SDL_QueryTexture(texture, NULL, NULL, &width, &height) != 0) return 0;
+	return static_cast<unsigned long long> (width) * height * 4;
+}
+
+SDL_Texture * Window::countTexture(SDL_Texture *texture) {
+	textureBytes.fetch_add(getTextureSize(texture), std::memory_order_relaxed);
+	return texture;
+}
+
+void Window::destroyTexture(SDL_Texture *texture) {
+	if (texture == NULL) return;
+	textureBytes.fetch_sub(getTextureSize(texture), std::memory_order_relaxed);
+	SDL_DestroyTexture(texture);
+}
+
+unsigned long long Window::getTextureBytes() { return textureBytes.load(std::memory_order_relaxed); }
+
 SDL_Window * Window::getWindow() const { return win; }
 SDL_Renderer * Window::getWindowRenderer() const { return winRenderer; }
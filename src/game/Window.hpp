@@ -1,21 +1,39 @@
 #ifndef WINDOW_HPP
 #define WINDOW_HPP
 
+#include <vector>
+#include <atomic>
+#include <SDL2/SDL_rect.h>
+#include "RenderStats.hpp"
+
 struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Texture;
-struct SDL_Rect;
+struct SDL_Color;
 class BaseScreen;
 class Game;
 
 class Window {
 public:
-    Window();
+    //A headless window is hidden and draws with the software renderer, for machines without a display
+    Window(bool headless = false);
     ~Window();
 
-    //Draw the current screen
+    //Draw the visible screens, from the bottom of the screen stack up
+    //Skips the redraw and present when neither the window nor any of the screens is dirty, returns whether it drew
     //Should ONLY be called by the Game object's update
-    void render(BaseScreen *screen);
+    bool render(const std::vector<BaseScreen *> &screens);
+
+    //Force a full redraw on the next render (window exposed, screen changed...)
+    void invalidate();
+
+    //How far the game is into the current simulation step (0 to 1), for drawing between steps
+    void setInterpolation(float stepProgress);
+    float getInterpolation() const;
+
+    //What the renderer was asked to do over the last frames, log a summary every time the history fills up again
+    const RenderStats & getRenderStats() const;
+    void setLogRenderStats(bool log);
 
     //Getters for the SDL information if needed
 	SDL_Window * getWindow() const;
@@ -30,18 +48,50 @@ public:
     //Erase the current render target (paint it black)
 	void clearRenderTarget() const;
 
+    //Overwrite part of the current render target with black or fully transparent pixels
+    void eraseRect(const SDL_Rect &rect, bool transparent) const;
+
     //Draw a texture to the current render target
-    void drawTexture(SDL_Texture *texture, SDL_Rect *srcRect, SDL_Rect *dstRect) const;
+    //While a camera is set the destination rect is in camera (world) coordinates
+    void drawTexture(SDL_Texture *texture, const SDL_Rect *srcRect, const SDL_Rect *dstRect) const;
+
+    //Map the world space region view onto the whole window for the following draws
+    void setCamera(const SDL_Rect &view);
+
+    //Go back to drawing in window coordinates
+    void resetCamera();
 	
+    //Fill rects with a color in one go (ie: the bars of a graph)
+    void fillRects(const SDL_Rect *rects, int count, const SDL_Color &color) const;
+
     //Create a new transparent texture
     SDL_Texture * createTransparentTexture(int width, int height) const;
 	
     //Create a new blank (all black) texture
     SDL_Texture * createTexture(int width, int height) const;
 
+    //Every texture the game makes is counted and destroyed through here, from any thread,
+    //so the window knows how much texture memory is resident (at 4 bytes a pixel, whatever the driver does with it)
+    static SDL_Texture * countTexture(SDL_Texture *texture);
+    static void destroyTexture(SDL_Texture *texture);
+    static unsigned long long getTextureBytes();
+
 private:
     SDL_Window *win;
     SDL_Renderer *winRenderer;
+    bool dirty;
+    float interpolation;
+    bool cameraSet;
+    SDL_Rect camera;
+
+    //Drawing doesn't change what is drawn to, but it is counted
+    mutable RenderStats stats;
+    mutable SDL_Texture *lastTexture, *currentTarget;
+    mutable int targetWidth, targetHeight;
+    static std::atomic<unsigned long long> textureBytes;
+
+    SDL_Rect toWindowRect(const SDL_Rect &worldRect) const;
+    void switchTarget(SDL_Texture *targetTexture) const;
 };
 
 #endif
@@ -2,6 +2,7 @@
 #include "Tileset.hpp"
 #include "Tile.hpp"
 
+#include <cstring>
 #include "../util/Constants.hpp"
 #include "../game/Game.hpp"
 #include "../util/Util.hpp"
@@ -9,131 +10,72 @@
 #include "MapLoader.hpp"
 
 Map::Map() :
-	mapName(NULL), width(0), height(0), generated(false), tileset(NULL) {
-	borderingMaps = new char *[4]{ NULL,NULL,NULL,NULL };
-}
-
-Map::Map(int w, int h, std::vector<int **>tileCoords, Tileset *tileset) :
-	mapName(NULL), width(w), height(h), generated(false), mapTiles(tileCoords), tileset(tileset) {
-	borderingMaps = new char *[4]{ NULL,NULL,NULL,NULL };
+	arena(Constants::MAP_ARENA_SIZE), mapName(NULL), width(0), height(0), generated(false), tilesetTexture(NULL), tileset(NULL) {
 }
 
 Map::~Map() {
-	if (mapName != NULL) {
-		delete mapName;
-		mapName = NULL;
-	}
-
-	//Delete the bordering maps information
-	for (int i = 0; i < 0; i++) if (borderingMaps[i] != NULL) delete[] borderingMaps[i];
-	delete[] borderingMaps; borderingMaps = NULL;
-
-	//Clear the map tiles
-	for (unsigned int j = 0; j < mapTiles.size(); j++) {
-		for (int i = 0; i < width; i++) {
-			delete[] mapTiles[j][i];
-			mapTiles[j][i] = NULL;
-		}
-		delete[] mapTiles[j];
-		mapTiles[j] = NULL;
-	}
+	//The names and tiles go with the arena
+	mapName = NULL;
+	mapTiles.clear();
 
-	//Delete the map textures
-	for (unsigned int i = 0; i < mapTextures.size(); i++) {
-		SDL_DestroyTexture(mapTextures[i]);
-		mapTextures[i] = NULL;
-	}
-	mapTextures.clear();
-	
-	//Map loader will handle deletion of tilesets
+	//The game owns the tileset image (the handle lets go of it), map loader will handle deletion of tilesets
+	tilesetTexture = NULL;
 	tileset = NULL;
 }
 
 void Map::generate(Game *game) {
 	if (width == 0 || height == 0 || generated || tileset == NULL) return;
-
-	Sprite *tilesetSprite = game->getSpriteSheet(tileset->getImagePath())->createSprite();
-	Window *win = game->getWindow();
-
-	for (unsigned int layer = 0; layer < mapTiles.size(); layer++) {
-		SDL_Texture *layerTexture = NULL;
-		
-		//Create a black texture on the bottom layer
-		if (layer == 0) {
-			layerTexture = win->createTexture(width * getTileWidth(), height * getTileHeight());
-		}
-
-		//Create a transparent texture for all other layers
-		else {
-			layerTexture = win->createTransparentTexture(width * getTileWidth(), height * getTileHeight());
-		}
-
-		//Change the render target to the layer texture
-		win->setRenderTarget(layerTexture);
-
-		for (int y = 0; y < height; y++) {
-			for (int x = 0; x < width; x++) {
-				if (mapTiles[layer][x][y] - 1 < 0) continue;
-				Tile *currTile = getTileset()->getTile(mapTiles[layer][x][y] - 1);
-                if(currTile == NULL) Util::fatalError("Current tile is null while generating map");
-                SDL_Rect src = Util::createRect(currTile->getRow() * getTileWidth(),
-					currTile->getColumn() * getTileHeight(),
-					getTileWidth(),
-					getTileHeight());
-				SDL_Rect dst = Util::createRect(x * getTileWidth(),
-					y * getTileHeight(),
-					getTileWidth(),
-					getTileHeight());
-				tilesetSprite->setSrcRect(src);
-				tilesetSprite->setDstRect(dst);
-				tilesetSprite->draw(win);
-				currTile = NULL;
-			}
-		}
-
-
-		//Set the render target back to the window texture
-		win->resetRenderTarget();
-
-		mapTextures.push_back(layerTexture);
-	}
-	
-	win = NULL;
-	delete tilesetSprite;
-	tilesetSprite = NULL;
+	tilesetImage = game->getSpriteSheet(tileset->getImageId());
+	if (!tilesetImage.isReady()) Util::fatalError("Failed to find the tileset image while generating map");
+	tilesetTexture = tilesetImage->getTexture();
+	generated = true;
 }
 
 Tile * Map::getTile(unsigned int layer, int tileX, int tileY) const {
-    if(layer > getNumberOfLayers() || tileX > getWidth() || tileY > getHeight()) return NULL;
+    if(layer >= getNumberOfLayers() || tileX < 0 || tileY < 0 || tileX >= getWidth() || tileY >= getHeight()) return NULL;
     return getTileset()->getTile(mapTiles[layer][tileX][tileY] - 1); 
 }
 Tileset * Map::getTileset() const { return tileset; }
-unsigned int Map::getNumberOfLayers() const { return mapTextures.size(); }
+unsigned int Map::getNumberOfLayers() const { return mapTiles.size(); }
 int Map::getWidth() const { return width; }
 int Map::getHeight() const { return height; }
 int Map::getTileWidth() const { return getTileset()->getTile(0) == NULL ? 0 : getTileset()->getTileWidth(); } 
 int Map::getTileHeight() const { return getTileset()->getTile(0) == NULL ? 0 : getTileset()->getTileHeight(); }
 std::vector<int **> Map::getLayersAsArray() const { return mapTiles; }
-SDL_Texture * Map::getLayer(unsigned int layer) const { return layer < mapTextures.size() ? mapTextures[layer] : NULL; }
+SDL_Texture * Map::getTilesetTexture() const { return tilesetTexture; }
 
 void Map::setTileset(Tileset *ts) { this->tileset = ts; }
 void Map::setWidth(int w) { this->width = w; }
 void Map::setHeight(int h) { this->height = h; }
-void Map::addLayer(int **tiles) { this->mapTiles.push_back(tiles); }
+int ** Map::addLayer(int layerWidth, int layerHeight) {
+	//One block for the tiles, the columns point into it
+	int **columns = arena.allocateArray<int *>(layerWidth);
+	int *tiles = arena.allocateArray<int>(layerWidth * layerHeight);
+	memset(tiles, 0, sizeof(int) * layerWidth * layerHeight);
+	for (int i = 0; i < layerWidth; i++) columns[i] = tiles + i * layerHeight;
+	mapTiles.push_back(columns);
+	return columns;
+}
 void Map::setBorderingMap(MapDirection direction, const char *map) {
-	int size = 0; while (map[size] != '\0') size++; int dir = static_cast<int>(direction);
-	if (borderingMaps[dir] != NULL) delete borderingMaps[dir];
-	borderingMaps[dir] = new char[size + 1];
-	strcpy(borderingMaps[dir], map);
+	borderingMaps[static_cast<int>(direction)] = AssetId(map);
 }
 Map * Map::getBorderingMap(MapDirection direction) const {
-	return borderingMaps[static_cast<int>(direction)] == NULL ? 
-		NULL : MapLoader::getInstance()->getMap(borderingMaps[static_cast<int>(direction)]);
+	return MapLoader::getInstance()->getMap(borderingMaps[static_cast<int>(direction)]);
 }
-void Map::setMapName(const char *name) {
-	if (mapName != NULL) delete mapName;
-	int size = 0; while (name[size] != '\0') size++;
-	mapName = new char[size + 1];
-	strcpy(mapName, name);
+void Map::setMapName(const char *name) { mapName = arena.copyString(name); }
+
+Map * Map::repeat(int across, int down, const char *name) const {
+	Map *copy = new Map();
+	copy->setTileset(tileset);
+	copy->setWidth(width * across);
+	copy->setHeight(height * down);
+	copy->setMapName(name);
+	for (unsigned int layer = 0; layer < mapTiles.size(); layer++) {
+		int **tiles = copy->addLayer(copy->width, copy->height);
+		for (int x = 0; x < copy->width; x++) {
+			for (int y = 0; y < copy->height; y++) tiles[x][y] = mapTiles[layer][x % width][y % height];
+		}
+	}
+	return copy;
 }
 std::string Map::getMapName() const { return std::string(mapName); }
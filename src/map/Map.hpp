@@ -3,18 +3,21 @@
 
 #include <vector>
 #include <string>
+#include "../util/Arena.hpp"
+#include "../util/ResourceHandle.hpp"
 
 class Tileset;
 class Tile;
 class Game;
+class SpriteSheet;
 struct SDL_Texture;
 
 typedef enum MapDirection { MAP_NORTH = 0, MAP_SOUTH = 1, MAP_EAST = 2, MAP_WEST = 3 } MapDirection;
 
 class Map {
 public:
+	//Everything the map loads lives in its own arena, unloading a map frees it all as one block
 	Map();
-	Map(int width, int height, std::vector<int **> tileLayers, Tileset *tileset);
 	~Map();
 
 	Tileset * getTileset() const;
@@ -25,28 +28,36 @@ public:
     int getTileHeight() const;
 	unsigned int getNumberOfLayers() const;
     std::vector<int **> getLayersAsArray() const;
-	SDL_Texture * getLayer(unsigned int layer) const;
+	SDL_Texture * getTilesetTexture() const;
 
 	void setTileset(Tileset *tileset);
 	void setWidth(int width);
 	void setHeight(int height);
-	void addLayer(int **layer);
+	//A new layer of tile ids (all 0, no tile), indexed by [tileX][tileY]
+	int ** addLayer(int layerWidth, int layerHeight);
 	void setBorderingMap(MapDirection direction, const char *map);
 	Map * getBorderingMap(MapDirection direction) const;
 	void setMapName(const char *name);
 	std::string getMapName() const;
 
+	//A new map of copies of this one side by side, across by down of them, with the same tileset and no bordering maps
+	//The caller owns it and generates it, for when the world needs more room than any map has (like the stress test)
+	Map * repeat(int across, int down, const char *name) const;
+
 	//Generate the map from the information given to the map
+	//Maps are drawn tile by tile, so this only looks up the tileset image (and keeps it loaded)
 	void generate(Game *game);
 
 private:
+	Arena arena;
 	char *mapName;
-	char ** borderingMaps;
+	AssetId borderingMaps[4];
 	int width;
 	int height;
 	bool generated;
 	std::vector<int **> mapTiles;
-	std::vector<SDL_Texture *> mapTextures;
+	ResourceHandle<SpriteSheet> tilesetImage;
+	SDL_Texture *tilesetTexture;
 	Tileset *tileset;
 };
 
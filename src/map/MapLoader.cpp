@@ -1,10 +1,14 @@
 #include "MapLoader.hpp"
 
 #include <string>
+#include <cstdlib>
 #include <SDL2/SDL.h>
 #include "Maps.hpp"
+#include "../game/Game.hpp"
 #include "../util/Utils.hpp"
 #include "../util/XMLParser.hpp"
+#include "../util/AllocationTracker.hpp"
+#include "../util/Trace.hpp"
 
 MapLoader * MapLoader::instance = NULL;
 
@@ -22,14 +26,12 @@ void MapLoader::deleteInstance() {
 	}
 }
 
-MapLoader::MapLoader() {}
+MapLoader::MapLoader() : loadLock(SDL_CreateMutex()), loaded(false) {
+	if (loadLock == NULL) Util::fatalSDLError("Failed to create the map loader lock");
+}
 
 MapLoader::~MapLoader() {
-    for(std::map<std::string, Map *>::const_iterator iterator = maps.begin(); iterator != maps.end(); ++iterator) {
-        if(iterator->second != NULL) {
-            delete iterator->second;
-        }
-    }
+    maps.forEach([](Map *map) { delete map; });
     maps.clear();
 	
     for (unsigned int i = 0; i < tilesets.size(); i++) {
@@ -39,35 +41,71 @@ MapLoader::~MapLoader() {
 		}
 	}
 	tilesets.clear();
+	SDL_DestroyMutex(loadLock);
+	loadLock = NULL;
 }
 
-Map * MapLoader::getMap(const std::string &mapId) const {
-    std::map<std::string, Map *>::const_iterator iterator = maps.find(mapId);
-    Map *map = NULL;
-    if(iterator != maps.end()) {
-        map = iterator->second;
-    }
-    return map;
+Map * MapLoader::getMap(const AssetId &mapId) const {
+    Map * const *map = maps.find(mapId);
+    return map == NULL ? NULL : *map;
+}
+
+bool MapLoader::addMap(Map *map) {
+    std::string name = map->getMapName();
+    return maps.insert(AssetId(name), name.c_str(), map);
 }
 
 void MapLoader::loadAll(Game *game, const char *pathToResFolder) {
+    TRACE_SCOPE("MapLoader::loadAll");
+    AllocationScope allocations(ALLOCATION_LOADER);
+    //Every screen that needs the maps preloads them, the first one does the loading
+    //Nothing reads the maps before a screen that preloaded them starts, so only loading takes the lock
+    SDL_LockMutex(loadLock);
+    if(loaded) {
+        SDL_UnlockMutex(loadLock);
+        return;
+    }
+
     std::vector<std::string> tilesetFiles = FileUtil::getFilesRecursively(pathToResFolder, Constants::TILESET_FILE_EXTENSION);
     if(tilesetFiles.size() == 0) { 
 		Util::fatalError("Warning: Failed to find tilesets in given res folder"); 
 	}
+    std::vector<std::string> mapFiles = FileUtil::getFilesRecursively(pathToResFolder, Constants::MAP_FILE_EXTENSION);
+
+    //Reading and parsing the files doesn't depend on anything else, so it runs on every core
+    //Maps need their tilesets, so they are put together afterwards in order
+    //Every file is parsed into an arena of its own, which goes in one go once the file is loaded
+    std::vector<std::string> files(tilesetFiles);
+    files.insert(files.end(), mapFiles.begin(), mapFiles.end());
+    std::vector<XMLObject *> parsed(files.size(), NULL);
+    std::vector<Arena *> arenas(files.size(), NULL);
+    game->getJobs()->parallelFor(files.size(), 1, [&files, &parsed, &arenas](unsigned int begin, unsigned int end) {
+        AllocationScope allocations(ALLOCATION_LOADER);
+        for(unsigned int i = begin; i < end; i++) {
+            arenas[i] = new Arena(Constants::MAP_LOAD_ARENA_SIZE);
+            parsed[i] = XMLParser::loadXML(files[i].c_str(), arenas[i]);
+        }
+    });
+
     for(size_t i = 0; i < tilesetFiles.size(); i++) {
-        loadTileset(tilesetFiles[i].c_str());
+        loadTileset(parsed[i]);
+        delete arenas[i];
         Util::log(SDL_LOG_PRIORITY_INFO, "Successfully loaded tileset " + tilesetFiles[i]);
     }
-    std::vector<std::string> maps = FileUtil::getFilesRecursively(pathToResFolder, Constants::MAP_FILE_EXTENSION);
-    for(size_t i = 0; i < tilesetFiles.size(); i++) {
-        loadMap(game, maps[i].c_str());
-        Util::log(SDL_LOG_PRIORITY_INFO, "Successfully loaded map " + maps[i]);
+    for(size_t i = 0; i < mapFiles.size(); i++) {
+        loadMap(parsed[tilesetFiles.size() + i], mapFiles[i].c_str());
+        delete arenas[tilesetFiles.size() + i];
+        Util::log(SDL_LOG_PRIORITY_INFO, "Successfully loaded map " + mapFiles[i]);
     }
+    loaded = true;
+    SDL_UnlockMutex(loadLock);
+}
+
+void MapLoader::generateAll(Game *game) {
+    maps.forEach([game](Map *map) { map->generate(game); });
 }
 
-void MapLoader::loadTileset(const char *pathToTileset) {
-	XMLObject *obj = XMLParser::loadXML(pathToTileset);
+void MapLoader::loadTileset(XMLObject *obj) {
 	if (obj == NULL) {
 		Util::fatalError("Failed to load tileset");
 	}
@@ -79,16 +117,16 @@ void MapLoader::loadTileset(const char *pathToTileset) {
 		//Load the name and number of columns of the tileset
 		for (unsigned int i = 0; i < obj->tags[0]->attributes.size(); i++) {
             if (obj->tags[0]->attributes[i].first == "name") {
-				tileset->setName(obj->tags[0]->attributes[i].second);
+				tileset->setName(obj->tags[0]->attributes[i].second.c_str());
 			}
 			else if (obj->tags[0]->attributes[i].first == "columns") {
-				tileColumns = std::stoi(obj->tags[0]->attributes[i].second);
+				tileColumns = atoi(obj->tags[0]->attributes[i].second.c_str());
 			}
             else if(obj->tags[0]->attributes[i].first == "tilewidth") {
-                width = std::stoi(obj->tags[0]->attributes[i].second);
+                width = atoi(obj->tags[0]->attributes[i].second.c_str());
             }
             else if(obj->tags[0]->attributes[i].first == "tileheight") {
-                height = std::stoi(obj->tags[0]->attributes[i].second);
+                height = atoi(obj->tags[0]->attributes[i].second.c_str());
             }
 		}
         tileset->setTileWidth(width);
@@ -102,26 +140,26 @@ void MapLoader::loadTileset(const char *pathToTileset) {
 			if (tag->id == "image") {
 				for (unsigned int j = 0; j < tag->attributes.size(); j++) {
 					if (tag->attributes[j].first == "source") {
-						tileset->setImageFile(FileUtil::getFileName(tag->attributes[j].second.substr(9).c_str()).c_str());
+						tileset->setImageFile(FileUtil::getFileName(tag->attributes[j].second.c_str() + 9).c_str());
 						break;
 					}
 				}
 			}
 			else if (tag->id == "tile") {
 				int id;
-				std::string type;
+				const char *type = "";
                 for (unsigned int j = 0; j < tag->attributes.size(); j++) {
 					if (tag->attributes[j].first == "id") {
-						id = std::stoi(tag->attributes[j].second);
+						id = atoi(tag->attributes[j].second.c_str());
 					}
 					else if (tag->attributes[j].first == "type") {
-						type = tag->attributes[j].second;
+						type = tag->attributes[j].second.c_str();
 					}
 				}
-                tileset->addTile(new Tile(type,
+                tileset->addTile(type,
 					id,
 					x,
-					row));
+					row);
 				x++;
 				if (x % tileColumns == 0) {
 					row++; x = 0;
@@ -131,22 +169,41 @@ void MapLoader::loadTileset(const char *pathToTileset) {
 		}
 	}
 	tilesets.push_back(tileset);
-	XMLParser::destroyXMLObject(obj);
-	obj = NULL;
 }
 
-void MapLoader::loadMap(Game *game, const char *path) {
+void MapLoader::loadMap(XMLObject *obj, const char *path) {
 	Map *map = new Map();
-	XMLObject *obj = XMLParser::loadXML(path);
 	if (obj == NULL) {
 		Util::fatalError("Failed to load map");
 	}
 	for (unsigned int i = 0; i < obj->tags.size(); i++) {
 		populateMapInfo(obj->tags[i], map);
 	}
-	XMLParser::destroyXMLObject(obj);
-	map->generate(game);
-	maps.insert(std::pair<std::string, Map *> (FileUtil::getFileName(path), map));
+	std::string fileName = FileUtil::getFileName(path);
+	maps.insert(AssetId(fileName), fileName.c_str(), map);
+}
+
+void MapLoader::parseLayer(const char *tileData, size_t length, int **layer, int width, int height) {
+    //The tile ids are numbers separated by anything else, filled in row by row
+    int nextInt = 0;
+    bool readingInt = false;
+    int currRow = 0, currCol = 0;
+    for(size_t i = 0; i < length && currCol < height; i++) {
+        if(tileData[i] >= '0' && tileData[i] <= '9') {
+            nextInt = nextInt * 10 + (tileData[i] - '0');
+            readingInt = true;
+        }
+        else if(readingInt) {
+            layer[currRow][currCol] = nextInt;
+            currRow++;
+            if(currRow == width) {
+                currRow = 0;
+                currCol++;
+            }
+            nextInt = 0;
+            readingInt = false;
+        }
+    }
 }
 
 void MapLoader::populateMapInfo(Tag *tag, Map *map) {
@@ -157,10 +214,10 @@ void MapLoader::populateMapInfo(Tag *tag, Map *map) {
     if (tag->id == "map") {
 		for (unsigned int i = 0; i < tag->attributes.size(); i++) {
 			if (tag->attributes[i].first == "width") {
-				map->setWidth(std::stoi(tag->attributes[i].second));
+				map->setWidth(atoi(tag->attributes[i].second.c_str()));
 			}
 			else if (tag->attributes[i].first == "height") {
-				map->setHeight(std::stoi(tag->attributes[i].second));
+				map->setHeight(atoi(tag->attributes[i].second.c_str()));
 			}
 		}
 	}
@@ -169,9 +226,9 @@ void MapLoader::populateMapInfo(Tag *tag, Map *map) {
 	else if (tag->id == "tileset") {
 		for (unsigned int i = 0; i < tag->attributes.size(); i++) {
 			if (tag->attributes[i].first == "source") {
-				std::string ts = tag->attributes[i].second;
+				const XMLString &ts = tag->attributes[i].second;
 				for (unsigned int j = 0; j < tilesets.size(); j++) {
-					if ("../tileset/" + tilesets[j]->getName() + ".tsx" == ts) {
+					if (ts == ("../tileset/" + tilesets[j]->getName() + ".tsx").c_str()) {
 						map->setTileset(tilesets[j]);
 					}
 				}
@@ -204,48 +261,21 @@ void MapLoader::populateMapInfo(Tag *tag, Map *map) {
 
     //Load width, height, and data for each layer
 	else if (tag->id == "layer") {
-        int **layer = NULL;
 		int lwidth = 0, lheight = 0;
 		for (unsigned int i = 0; i < tag->attributes.size(); i++) {
 			if (tag->attributes[i].first == "width") {
-				lwidth = std::stoi(tag->attributes[i].second);
-				layer = new int*[lwidth];
+				lwidth = atoi(tag->attributes[i].second.c_str());
 			}
 			else if (tag->attributes[i].first == "height") {
-				lheight = std::stoi(tag->attributes[i].second);
-				if (layer != NULL) {
-					for (int j = 0; j < lwidth; j++) {
-						layer[j] = new int[lheight];
-					}
-				}
+				lheight = atoi(tag->attributes[i].second.c_str());
 			}
 		}
 		if (tag->subTags.size() > 0 
 			&& tag->subTags[0] != NULL
 			&& tag->subTags[0]->id == "data") {
-			std::string tileData = tag->subTags[0]->data;
-            std::string nextInt = "";
-            int currRow = 0, currCol = 0;
-            for(unsigned int i = 0; i < tileData.size(); i++) {
-                //using ASCII, 
-                //check to see if the next char is a number
-                int nextChar = (int)tileData[i] - (int) '0';
-                if(nextChar < 10 && nextChar >= 0) {
-                    nextInt += (char) (nextChar + '0');
-                }
-                else if(nextInt != "") {
-                    layer[currRow][currCol] = std::stoi(nextInt);
-                    currRow++;
-                    if(currRow == lwidth) {
-                        currRow = 0;
-                        currCol++;
-                    }
-                    if(currCol == lheight)
-                        break;
-                    nextInt = "";
-                }
-            }
-            map->addLayer(layer);
+            int **layer = map->addLayer(lwidth, lheight);
+			const XMLString &tileData = tag->subTags[0]->data;
+			parseLayer(tileData.c_str(), tileData.size(), layer, lwidth, lheight);
 		}
 	}
 
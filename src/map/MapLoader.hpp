@@ -1,33 +1,49 @@
 #ifndef MAP_LOADER_HPP
 #define MAP_LOADER_HPP
 
-#include <map>
+#include <stddef.h>
 #include <vector>
 #include <string>
+#include "../util/AssetTable.hpp"
 
 class Tileset;
 class Map;
 class Game;
 struct Tag;
+struct XMLObject;
+struct SDL_mutex;
 
 class MapLoader {
 public:
 	static MapLoader * getInstance();
 	static void deleteInstance();
 
+    //Read every tileset and map, only the first call loads anything, safe to call on any thread
     void loadAll(Game *game, const char *pathToRes);
-    Map * getMap(const std::string &mapId) const;
+
+    //Point the maps at their tileset textures, main thread only, once the tileset images are loaded
+    void generateAll(Game *game);
+    Map * getMap(const AssetId &mapId) const;
+
+    //Take a map made at runtime (not read from a file), it can be found by its name like the others and goes with the loader
+    //Main thread only, returns false (and leaves the map to the caller) if there's a map by that name already
+    bool addMap(Map *map);
+
+    //Read a layer's comma separated tile ids into layer[tileX][tileY]
+    static void parseLayer(const char *tileData, size_t length, int **layer, int width, int height);
 
 private:
 	MapLoader();
 	~MapLoader();
 	static MapLoader *instance;
 
-	void loadTileset(const char *pathToTileset);
-	void loadMap(Game *game, const char *pathToMap);
+	void loadTileset(XMLObject *obj);
+	void loadMap(XMLObject *obj, const char *pathToMap);
     void populateMapInfo(Tag *tag, Map *map);
 	std::vector<Tileset *> tilesets;
-    std::map<std::string, Map *> maps;
+    AssetTable<Map *> maps;
+    SDL_mutex *loadLock;
+    bool loaded;
 };
 
 #endif
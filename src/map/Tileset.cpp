@@ -1,51 +1,37 @@
 #include "Tileset.hpp"
 
 #include "Tile.hpp"
-#include <string.h>
+#include "../util/Constants.hpp"
 
-Tileset::Tileset() {
-    imageFilePath = NULL;
-}
-
-Tileset::Tileset(const std::string &name,
-    const char *imgPath,
-	int w,
-	int h,
-    int tW,
-    int tH,
-	const std::vector<Tile *> &tiles) 
-        : tilesetName(name), width(w), height(h), tileWidth(tW), tileHeight(tH), tiles(tiles) {
-    setImageFile(imgPath);
-}
+Tileset::Tileset() : arena(Constants::TILESET_ARENA_SIZE), imageFilePath(NULL), width(0), height(0), tileWidth(0), tileHeight(0) {}
 
 Tileset::~Tileset() {
+	//Only the tile type strings need their destructors, the memory goes with the arena
 	for (unsigned int i = 0; i < tiles.size(); i++) {
-		if (tiles[i] != NULL) {
-			delete tiles[i];
-			tiles[i] = NULL;
-		}
+		tiles[i]->~Tile();
+		tiles[i] = NULL;
 	}
 	tiles.clear();
-    if(imageFilePath != NULL) {
-        delete[] imageFilePath;
-        imageFilePath = NULL;
-    }
+    imageFilePath = NULL;
+}
+
+Tile * Tileset::addTile(const std::string &type, int id, int row, int column) {
+	Tile *tile = arena.create<Tile>(type, id, row, column);
+	tiles.push_back(tile);
+	return tile;
 }
 
-void Tileset::addTile(Tile *tile) { tiles.push_back(tile); }
 void Tileset::setDimensions(int w, int h) { width = w; height = h; }
 void Tileset::setName(const std::string &name) { tilesetName = name; }
-void Tileset::setImageFile(const char *imgPath) {
-	int pathLength = 0;
-    while(imgPath[pathLength] != '\0') pathLength++;
-    pathLength += 2;
-    this->imageFilePath = new char[pathLength];
-    strcpy(imageFilePath, imgPath);
+void Tileset::setImageFile(const char *imgPath) { 
+	imageFilePath = arena.copyString(imgPath); 
+	imageId = AssetId(imgPath);
 }
 void Tileset::setTileWidth(int tW) { tileWidth = tW; }
 void Tileset::setTileHeight(int tH) { tileHeight = tH; }
 
 char * Tileset::getImagePath() const { return imageFilePath; }
+AssetId Tileset::getImageId() const { return imageId; }
 Tile * Tileset::getTile(unsigned int index) const { return index >= tiles.size() ? NULL : tiles[index]; }
 int Tileset::getHeight() const { return height; }
 int Tileset::getWidth() const { return width; }
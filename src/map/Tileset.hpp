@@ -3,30 +3,27 @@
 
 #include <vector>
 #include <string>
+#include "../util/Arena.hpp"
+#include "../util/AssetId.hpp"
 
 class Tile;
 
 class Tileset {
 public: 
+	//The tiles live in the tileset's arena, they go as one block with it
 	Tileset();
-	Tileset(const std::string &name,
-        const char *imgPath, 
-		int w, 
-		int h,
-        int tW,
-        int tH,
-		const std::vector<Tile *> &tiles);
 	~Tileset();
 
 	void setDimensions(int w, int h);
 	void setImageFile(const char *imgPath);
-	void addTile(Tile *tile);
+	Tile * addTile(const std::string &type, int id, int row, int column);
     void setName(const std::string &name);
     void setTileWidth(int tW);
     void setTileHeight(int tH);
 
 	Tile * getTile(unsigned int) const;
 	char * getImagePath() const;
+	AssetId getImageId() const;
 	int getWidth() const;
 	int getHeight() const;
     int getTileWidth() const;
@@ -34,8 +31,10 @@ public:
     std::string getName() const;
 
 private:
+    Arena arena;
     std::string tilesetName;
     char *imageFilePath;
+    AssetId imageId;
 	int width;
 	int height;
 	int tileWidth;
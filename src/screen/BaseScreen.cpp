@@ -1,28 +1,33 @@
 #include "BaseScreen.hpp"
 #include "../game/Game.hpp"
-#include <SDL2/SDL.h>
+#include "../game/Window.hpp"
 
-BaseScreen::BaseScreen() {}
+BaseScreen::BaseScreen() : dirty(true) {}
 
 BaseScreen::~BaseScreen() {}
 
-void BaseScreen::handleInput(Game *game) {
-    //Game handles quit event//
-	SDL_Event e;
-	while (SDL_PollEvent(&e)) {
-		if (e.type == SDL_QUIT) {
-			game->quit();
-		}
-		else {
-			onInput(game, e);
-		}
-	}
-	const Uint8 *keyboard = SDL_GetKeyboardState(NULL);
-	onKeyInput(game, keyboard);
+void BaseScreen::handleInput(Game *game, const InputFrame &input) {
+	for (unsigned int i = 0; i < input.eventCount; i++) onInput(game, input.events[i]);
 }
 
+void BaseScreen::handleKeyInput(Game *game, const uint8_t *keys) { onKeyInput(game, keys); }
+
+void BaseScreen::handleEvent(Game *game, const GameEvent &event) { onGameEvent(game, event); }
+
+void BaseScreen::onGameEvent(Game *game, const GameEvent &event) {}
+
+void BaseScreen::publishSnapshot(Game *game) {}
+void BaseScreen::acquireSnapshot() {}
+
+void BaseScreen::preload(Game *game) {}
 void BaseScreen::start(Game *game) {}
 void BaseScreen::pause(Game *game) {}
 void BaseScreen::resume(Game *game) {}
 void BaseScreen::stop(Game *game) {}
 
+bool BaseScreen::isOverlay() const { return false; }
+
+void BaseScreen::markDirty() { dirty = true; }
+bool BaseScreen::isDirty() const { return dirty; }
+void BaseScreen::clearDirty() { dirty = false; }
+
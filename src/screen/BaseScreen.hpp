@@ -2,32 +2,61 @@
 #define BASE_SCREEN_HPP
 
 #include <vector>
+#include <atomic>
 #include <stdint.h>
+#include "../game/GameEvent.hpp"
+#include "../game/InputFrame.hpp"
 
 class Game;
 class Window;
 class Sprite;
 struct SDL_Renderer;
-union SDL_Event;
 
 class BaseScreen {
 public:
     BaseScreen();
     virtual ~BaseScreen();
     
-	//Screen Lifecycle
+	/* Screen Lifecycle
+	 * preload runs on a worker thread as soon as the screen is requested, the screen only starts once it is done,
+	 * so slow loading happens while the current screen keeps going. Textures can't be made there, leave them to start
+	 * A screen pushed over this one pauses it until it is popped again, then it resumes */
+	virtual void preload(Game *game);
 	virtual void start(Game *game);
 	virtual void pause(Game *game);
 	virtual void resume(Game *game);
 	virtual void stop(Game *game);
 	virtual void render(Window *win) = 0;
 
-	void handleInput(Game *game);
+	//An overlay (ie: a menu) is drawn over the screens under it instead of hiding them
+	virtual bool isOverlay() const;
+
+	//Called on the simulation thread, window events as they are polled and the keyboard once before every step
+	void handleInput(Game *game, const InputFrame &input);
+	void handleKeyInput(Game *game, const uint8_t *keys);
+	void handleEvent(Game *game, const GameEvent &event);
+
+	/* Rendering happens on the main thread while the simulation runs on its own
+	 * After every simulation step the screen copies what it draws into a snapshot (simulation thread),
+	 * before every frame it switches to the newest snapshot (main thread), render only reads that one */
+	virtual void publishSnapshot(Game *game);
+	virtual void acquireSnapshot();
+
+	//Damage tracking, the window only redraws a screen while it is dirty
+	void markDirty();
+	virtual bool isDirty() const;
+	virtual void clearDirty();
 
 protected:
 
     virtual void onInput(Game *game, const SDL_Event &event) = 0;
 	virtual void onKeyInput(Game *game, const uint8_t *keys) = 0;
+
+	//Events posted to the game from any thread, called on the main thread while the simulation waits
+	virtual void onGameEvent(Game *game, const GameEvent &event);
+
+private:
+	std::atomic<bool> dirty;
 };
 
 #endif
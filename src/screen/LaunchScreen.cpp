@@ -5,9 +5,8 @@
 #include "../game/Game.hpp"
 #include "../sprite/Sprites.hpp"
 #include "../util/Utils.hpp"
-#include "../map/MapLoader.hpp"
 
-LaunchScreen::LaunchScreen() : BaseScreen(), loadingText(NULL), hasDrawn(false) {}
+LaunchScreen::LaunchScreen() : BaseScreen(), loadingText(NULL) {}
 
 LaunchScreen::~LaunchScreen() {
     if(loadingText != NULL) {
@@ -17,30 +16,22 @@ LaunchScreen::~LaunchScreen() {
 }
 
 void LaunchScreen::start(Game *game) {
-	game->schedule(this);
-	loadingText = game->getFont(Constants::FONT_JOYSTIX)->createFontSprite(game->getWindow(), "Loading");
+	loadingFont = game->getFont(Constants::FONT_JOYSTIX);
+	if (!loadingFont.isReady()) Util::fatalError("Failed to find the loading screen font");
+	loadingText = loadingFont->createFontSprite(game->getWindow(), "Loading");
 	loadingText->setColor(game->getWindow(), Constants::COLOR_WHITE);
 	loadingText->getSprite()->setDstRect(Util::createRectCenteredHorizontally(450, 150, 25));
-}
 
-void LaunchScreen::stop(Game *game) {
-	game->unschedule(this);
+	//The world loads in the background, this screen stays up until it is done
+	game->requestNewScreen(new WorldScreen());
 }
 
+void LaunchScreen::stop(Game *) {}
+
 void LaunchScreen::render(Window *win) {
     loadingText->draw(win);
-	hasDrawn = true;
 }
 
 void LaunchScreen::onInput(Game *, const SDL_Event &) {}
 
 void LaunchScreen::onKeyInput(Game *, const uint8_t *) {}
-
-void LaunchScreen::onGameTick(Game *game) {
-	if (!hasDrawn) return;
-	std::vector<std::string> imageFiles = FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::IMAGE_FILE_EXTENSION);
-	for (unsigned int i = 0; i < imageFiles.size(); i++) game->loadSpriteSheet(imageFiles[i].c_str());
-	MapLoader::getInstance()->loadAll(game, Constants::GAME_RES_FOLDER);
-	game->unschedule(this);
-	game->requestNewScreen(new WorldScreen());
-}
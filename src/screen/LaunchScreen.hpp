@@ -2,13 +2,13 @@
 #define LAUNCH_SCREEN_HPP
 
 #include "BaseScreen.hpp"
-#include "../game/BaseGameObject.hpp"
 #include <string>
+#include "../util/ResourceHandle.hpp"
 
 class FontSprite;
-class LaunchScreenLoader;
+class Font;
 
-class LaunchScreen : public BaseScreen, public BaseGameObject {
+class LaunchScreen : public BaseScreen {
 public:
     LaunchScreen();
     ~LaunchScreen() override;
@@ -20,12 +20,11 @@ public:
 protected:
     void onInput(Game *game, const SDL_Event &event) override;
     void onKeyInput(Game *game, const uint8_t *keys) override;
-	void onGameTick(Game *game) override;
 
 private:
-	//Sprites
+	//Sprites, the text holds on to the font
+	ResourceHandle<Font> loadingFont;
 	FontSprite *loadingText;
-	bool hasDrawn;
 };
 
 #endif
@@ -0,0 +1,149 @@
+#include "PerfHud.hpp"
+
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include "../game/Game.hpp"
+#include "../game/Window.hpp"
+#include "../sprite/Font.hpp"
+#include "../sprite/GlyphAtlas.hpp"
+#include "../util/Constants.hpp"
+#include "../util/Timer.hpp"
+#include "../util/Util.hpp"
+#include "../util/AllocationTracker.hpp"
+
+//Space around the panel's contents and between its parts
+static const int PADDING = 4;
+
+PerfHud::PerfHud() : BaseScreen(), atlas(NULL), textTimer(new Timer(Constants::PERF_HUD_TEXT_DELAY)),
+	samples(Constants::PERF_HUD_SAMPLES), next(0), recorded(0), textWidth(0) {
+	fastBars.reserve(samples.size());
+	slowBars.reserve(samples.size());
+	for (unsigned int i = 0; i < 4; i++) lines[i][0] = '\0';
+}
+
+PerfHud::~PerfHud() {
+	delete atlas;
+	atlas = NULL;
+	delete textTimer;
+	textTimer = NULL;
+}
+
+void PerfHud::start(Game *game) {
+	if (font.isEmpty()) font = game->getFont(Constants::FONT_JOYSTIX);
+	next = 0;
+	recorded = 0;
+	markDirty();
+}
+
+void PerfHud::stop(Game *) {}
+
+bool PerfHud::isOverlay() const { return true; }
+
+void PerfHud::onInput(Game *, const SDL_Event &) {}
+void PerfHud::onKeyInput(Game *, const uint8_t *) {}
+
+void PerfHud::addSample(const PerfSample &sample) {
+	samples[next] = sample;
+	next = (next + 1) % samples.size();
+	if (recorded < samples.size()) recorded++;
+	markDirty();
+}
+
+/**
+ * Sum up the samples into the lines of text
+ * Formatted into fixed buffers, so refreshing the text doesn't allocate
+ */
+void PerfHud::updateText() {
+	unsigned long long frameUs = 0, maxFrameUs = 0, stepNs = 0, maxStepNs = 0, steps = 0;
+	unsigned int frames = 0;
+	for (unsigned int i = 0; i < recorded; i++) {
+		const PerfSample &sample = samples[i];
+		if (sample.frameUs == 0) continue;
+		frames++;
+		frameUs += sample.frameUs;
+		if (sample.frameUs > maxFrameUs) maxFrameUs = sample.frameUs;
+		steps += sample.steps;
+		stepNs += sample.stepNs;
+		if (sample.steps > 0 && sample.stepNs / sample.steps > maxStepNs) maxStepNs = sample.stepNs / sample.steps;
+	}
+	double seconds = frameUs / 1e6;
+	const PerfSample &last = samples[(next + samples.size() - 1) % samples.size()];
+
+	snprintf(lines[0], sizeof(lines[0]), "FPS %4.0f  frame %6.2f ms  max %6.2f",
+		seconds > 0 ? frames / seconds : 0.0, frames > 0 ? frameUs / 1000.0 / frames : 0.0, maxFrameUs / 1000.0);
+	snprintf(lines[1], sizeof(lines[1]), "TPS %4.0f  tick  %6.3f ms  max %6.3f",
+		seconds > 0 ? steps / seconds : 0.0, steps > 0 ? stepNs / 1e6 / steps : 0.0, maxStepNs / 1e6);
+	snprintf(lines[2], sizeof(lines[2]), "objects %u  textures %.1f MB",
+		recorded > 0 ? last.scheduledObjects : 0, (recorded > 0 ? last.textureBytes : 0) / (1024.0 * 1024.0));
+	if (AllocationTracker::isAvailable()) {
+		snprintf(lines[3], sizeof(lines[3]), "draw calls %llu  allocations %llu",
+			recorded > 0 ? last.drawCalls : 0, recorded > 0 ? last.allocations : 0);
+	}
+	else {
+		snprintf(lines[3], sizeof(lines[3]), "draw calls %llu  allocations n/a", recorded > 0 ? last.drawCalls : 0);
+	}
+
+	textWidth = 0;
+	for (unsigned int i = 0; i < 4; i++) {
+		int width = atlas->getTextWidth(lines[i]);
+		if (width > textWidth) textWidth = width;
+	}
+}
+
+//Microseconds the frame took, or what its steps took on average
+unsigned long long PerfHud::getFrameValue(const PerfSample &sample, bool stepGraph) const {
+	if (!stepGraph) return sample.frameUs;
+	return sample.steps > 0 ? sample.stepNs / sample.steps / 1000 : 0;
+}
+
+/**
+ * One bar per sample, oldest on the left, the budget is half way up the graph
+ * Bars over the budget are red, the rest green, each color is filled in one call
+ */
+void PerfHud::drawGraph(Window *win, int x, int y, unsigned long long budget, bool stepGraph) {
+	const int height = Constants::PERF_HUD_GRAPH_HEIGHT;
+	fastBars.clear();
+	slowBars.clear();
+	unsigned int oldest = recorded < samples.size() ? 0 : next;
+	for (unsigned int i = 0; i < recorded; i++) {
+		unsigned long long value = getFrameValue(samples[(oldest + i) % samples.size()], stepGraph);
+		int barHeight = budget > 0 ? static_cast<int> (value * height / (budget * 2)) : 0;
+		if (barHeight > height) barHeight = height;
+		if (barHeight <= 0) continue;
+		SDL_Rect bar = Util::createRect(x + i, y + height - barHeight, 1, barHeight);
+		if (value > budget) slowBars.push_back(bar);
+		else fastBars.push_back(bar);
+	}
+	SDL_Rect budgetLine = Util::createRect(x, y + height / 2, samples.size(), 1);
+	win->fillRects(&budgetLine, 1, Util::createColor(90, 90, 90, Constants::SPRITE_ALPHA_FULL));
+	if (!fastBars.empty()) win->fillRects(&fastBars[0], fastBars.size(), Util::createColor(60, 200, 80, Constants::SPRITE_ALPHA_FULL));
+	if (!slowBars.empty()) win->fillRects(&slowBars[0], slowBars.size(), Util::createColor(230, 60, 50, Constants::SPRITE_ALPHA_FULL));
+}
+
+void PerfHud::render(Window *win) {
+	//The atlas needs the window, it is made the first time the overlay is drawn
+	if (atlas == NULL) {
+		if (!font.isReady()) return;
+		atlas = font->createGlyphAtlas(win, Constants::PERF_HUD_FONT_SIZE);
+		updateText();
+	}
+	if (textTimer->check()) updateText();
+
+	int lineHeight = atlas->getLineHeight();
+	int graphWidth = samples.size();
+	int width = (textWidth > graphWidth ? textWidth : graphWidth) + PADDING * 2;
+	int height = lineHeight * 4 + (Constants::PERF_HUD_GRAPH_HEIGHT + PADDING) * 2 + PADDING * 2;
+	SDL_Rect panel = Util::createRect(PADDING, PADDING, width, height);
+	win->fillRects(&panel, 1, Util::createColor(0, 0, 0, Constants::SPRITE_ALPHA_FULL));
+
+	int x = panel.x + PADDING, y = panel.y + PADDING;
+	SDL_Color textColor = Util::createColor(255, 255, 255, Constants::SPRITE_ALPHA_FULL);
+	for (unsigned int i = 0; i < 4; i++) {
+		atlas->draw(win, lines[i], x, y, textColor);
+		y += lineHeight;
+	}
+	y += PADDING;
+	drawGraph(win, x, y, 1000000 / Constants::TARGET_FPS, false);
+	y += Constants::PERF_HUD_GRAPH_HEIGHT + PADDING;
+	drawGraph(win, x, y, Constants::GAME_TICK_MICROSECONDS, true);
+}
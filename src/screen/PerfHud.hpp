@@ -0,0 +1,64 @@
+#ifndef PERF_HUD_HPP
+#define PERF_HUD_HPP
+
+#include "BaseScreen.hpp"
+#include <vector>
+#include <SDL2/SDL_rect.h>
+#include "../util/ResourceHandle.hpp"
+
+class Font;
+class GlyphAtlas;
+class Timer;
+
+//What the game measured for one frame drawn
+typedef struct PerfSample {
+	unsigned int frameUs;
+	unsigned int steps;
+	unsigned long long stepNs;
+	unsigned int scheduledObjects;
+	unsigned long long textureBytes;
+	unsigned long long drawCalls;
+	unsigned long long allocations;
+} PerfSample;
+
+/**
+ * Performance overlay, toggled with F3, drawn over whatever screens are showing
+ * Graphs the time between frames and the time the steps took over the last Constants::PERF_HUD_SAMPLES frames,
+ * with the numbers (fps, ticks per second, objects, texture memory, draw calls, allocations) refreshed a few times a second
+ * The text comes out of a glyph atlas, nothing is rendered with the font or allocated while it is showing
+ * It isn't on the screen stack, the game draws it on top and hands it a sample every frame (main thread)
+ */
+class PerfHud : public BaseScreen {
+public:
+	PerfHud();
+	~PerfHud() override;
+
+	void start(Game *game) override;
+	void stop(Game *game) override;
+	void render(Window *win) override;
+	bool isOverlay() const override;
+
+	void addSample(const PerfSample &sample);
+
+protected:
+	void onInput(Game *game, const SDL_Event &event) override;
+	void onKeyInput(Game *game, const uint8_t *keys) override;
+
+private:
+	ResourceHandle<Font> font;
+	GlyphAtlas *atlas;
+	Timer *textTimer;
+	std::vector<PerfSample> samples;
+	unsigned int next, recorded;
+
+	//Reused every frame
+	std::vector<SDL_Rect> fastBars, slowBars;
+	char lines[4][96];
+	int textWidth;
+
+	void updateText();
+	void drawGraph(Window *win, int x, int y, unsigned long long budget, bool stepGraph);
+	unsigned long long getFrameValue(const PerfSample &sample, bool stepGraph) const;
+};
+
+#endif
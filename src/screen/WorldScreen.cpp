@@ -4,7 +4,10 @@
 #include "../game/Game.hpp"
 #include "../world/World.hpp"
 #include "../world/WorldCharacter.hpp"
+#include "../world/CrowdStress.hpp"
 #include "../util/Constants.hpp"
+#include "../util/FileUtil.hpp"
+#include "../map/MapLoader.hpp"
 
 WorldScreen::WorldScreen() : BaseScreen(), world(new World()) {}
 
@@ -15,14 +18,40 @@ WorldScreen::~WorldScreen() {
     }
 }
 
-void WorldScreen::start(Game *game) { world->start(game); }
+void WorldScreen::preload(Game *game) {
+	//Decoding the images and reading the maps is most of the loading, start only has to make the textures
+	game->preloadSpriteSheets(FileUtil::getFilesRecursively(Constants::GAME_RES_FOLDER, Constants::IMAGE_FILE_EXTENSION));
+	MapLoader::getInstance()->loadAll(game, Constants::GAME_RES_FOLDER);
+}
+
+void WorldScreen::start(Game *game) {
+	MapLoader::getInstance()->generateAll(game);
+	world->start(game);
+	if(game->getCrowdStress() != NULL) game->getCrowdStress()->start(game, world);
+}
+
+void WorldScreen::pause(Game *game) { world->pause(game); }
+
+void WorldScreen::resume(Game *game) { world->resume(game); }
 
 void WorldScreen::stop(Game *game) { world->stop(game); }
 
 void WorldScreen::render(Window *win) { world->render(win); }
 
+void WorldScreen::publishSnapshot(Game *) { world->publishSnapshot(); }
+
+void WorldScreen::acquireSnapshot() { world->acquireSnapshot(); }
+
+World * WorldScreen::getWorld() const { return world; }
+
+bool WorldScreen::isDirty() const { return BaseScreen::isDirty() || world->isDirty(); }
+
+void WorldScreen::clearDirty() { BaseScreen::clearDirty(); world->clearDirty(); }
+
 void WorldScreen::onInput(Game *, const SDL_Event &) {}
 
+void WorldScreen::onGameEvent(Game *, const GameEvent &event) { world->handleEvent(event); }
+
 void WorldScreen::onKeyInput(Game *, const uint8_t *keys) {
 	WorldCharacter *player = static_cast<WorldCharacter *> (world->getPlayer());
     bool movePlayer = false;
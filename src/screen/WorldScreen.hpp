@@ -10,13 +10,23 @@ public:
 	WorldScreen();
     ~WorldScreen() override;
 
+	void preload(Game *game) override;
 	void start(Game *game) override;
+	void pause(Game *game) override;
+	void resume(Game *game) override;
 	void stop(Game *game) override;
 	void render(Window *win) override;
+	void publishSnapshot(Game *game) override;
+	void acquireSnapshot() override;
+	bool isDirty() const override;
+	void clearDirty() override;
+
+	World * getWorld() const;
 
 protected:
     void onInput(Game *game, const SDL_Event &event) override;
     void onKeyInput(Game *game, const uint8_t *keyboard) override;
+    void onGameEvent(Game *game, const GameEvent &event) override;
 
 private:
     World *world;
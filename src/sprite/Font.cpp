@@ -1,5 +1,6 @@
 #include "Font.hpp"
 #include "FontSprite.hpp"
+#include "GlyphAtlas.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "../util/Util.hpp"
@@ -7,14 +8,25 @@
 
 Font::Font(const char *fontFile) : file(fontFile) {}
 
-Font::~Font() {}
+Font::~Font() {
+    for(std::map<int, TTF_Font *>::const_iterator iterator = sizes.begin(); iterator != sizes.end(); ++iterator) {
+        TTF_CloseFont(iterator->second);
+    }
+    sizes.clear();
+}
 
-FontSprite * Font::createFontSprite(Window *win, const std::string &text, int pointSize) const {
-    TTF_Font *font = TTF_OpenFont(file.c_str(), pointSize);
+TTF_Font * Font::openSize(int pointSize) const {
+    TTF_Font *&font = sizes[pointSize];
+    if(font == NULL) font = TTF_OpenFont(file.c_str(), pointSize);
     if(font == NULL) {
         std::string message("Failed to open font: " + file);
         Util::fatalSDLError(message.c_str());
     }
+    return font;
+}
+
+FontSprite * Font::createFontSprite(Window *win, const std::string &text, int pointSize) const {
+    TTF_Font *font = openSize(pointSize);
     SDL_Color color;
     color.r = 0; color.b = 0; color.g = 0;
     color.a = Constants::SPRITE_ALPHA_FULL;
@@ -24,3 +36,7 @@ FontSprite * Font::createFontSprite(Window *win, const std::string &text, int po
 FontSprite * Font::createFontSprite(Window *win, const std::string &text) const  {
     return createFontSprite(win, text, DEFAULT_FONT_SIZE);
 }
+
+GlyphAtlas * Font::createGlyphAtlas(Window *win, int pointSize) const {
+    return new GlyphAtlas(win, openSize(pointSize));
+}
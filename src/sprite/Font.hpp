@@ -1,11 +1,13 @@
 #ifndef FONT_HPP
 #define FONT_HPP
 
+#include <map>
 #include <string>
 #include <SDL2/SDL_ttf.h>
 
 class Window;
 class FontSprite;
+class GlyphAtlas;
 
 #ifndef DEFAULT_FONT_SIZE
 #define DEFAULT_FONT_SIZE 20
@@ -16,11 +18,18 @@ public:
     Font(const char *fontFile);
     ~Font();
 
+    //Main thread only, every size is opened once and shared by all of its sprites
     FontSprite * createFontSprite(Window *win, const std::string &text, int pointSize) const;
     FontSprite * createFontSprite(Window *win, const std::string &text) const;
 
+    //Every character of one size in a single texture, for text that changes often, the caller owns the atlas
+    GlyphAtlas * createGlyphAtlas(Window *win, int pointSize) const;
+
 private:
     std::string file;
+    mutable std::map<int, TTF_Font *> sizes;
+
+    TTF_Font * openSize(int pointSize) const;
 };
 
 #endif
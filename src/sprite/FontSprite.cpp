@@ -2,80 +2,61 @@
 
 #include <SDL2/SDL_ttf.h>
 #include "../game/Window.hpp"
-#include "Sprite.hpp"
 #include "../util/Constants.hpp"
+#include "../util/ObjectPool.hpp"
+#include "../util/AllocationTracker.hpp"
 #include "../util/Util.hpp"
 
-FontSprite::FontSprite(Window *win, TTF_Font *targetFont, const std::string &newText, const SDL_Color &color) {
-    font = targetFont;
-    text = newText;
-    textColor = new SDL_Color;
-    *textColor = color;
-    texture = NULL;
-    sprite = NULL;
+static ObjectPool<FontSprite> & getPool() {
+    static ObjectPool<FontSprite> pool(Constants::FONT_SPRITE_POOL_SIZE);
+    return pool;
+}
+
+void * FontSprite::operator new(size_t size) { return getPool().allocate(size); }
+void FontSprite::operator delete(void *memory) { getPool().free(memory); }
+
+FontSprite::FontSprite(Window *win, TTF_Font *targetFont, const std::string &newText, const SDL_Color &color) 
+    : text(newText), font(targetFont), textColor(color), sprite(NULL), texture(NULL) {
     createNewFontTexture(win);
 }
 
 FontSprite::~FontSprite() {
-    if(textColor != NULL) {
-        delete textColor;
-        textColor = NULL;
-    }
     if(texture != NULL) {
-        SDL_DestroyTexture(texture);
+        Window::destroyTexture(texture);
         texture = NULL;
     }
-    if(sprite != NULL) {
-        delete sprite;
-        sprite = NULL;
-    }
-    if(font != NULL) {
-        TTF_CloseFont(font);
-        font = NULL;
-    }
+    font = NULL;
 }
 
 void FontSprite::createNewFontTexture(Window *win) {
+    AllocationScope allocations(ALLOCATION_TEXT);
     if(texture != NULL) {
-        SDL_DestroyTexture(texture);
+        Window::destroyTexture(texture);
     }
-    SDL_Surface *tempSurface = TTF_RenderText_Blended_Wrapped(font, text.c_str(), *textColor, Constants::WINDOW_WIDTH);
-    texture = SDL_CreateTextureFromSurface(win->getWindowRenderer(), tempSurface);
+    SDL_Surface *tempSurface = TTF_RenderText_Blended_Wrapped(font, text.c_str(), textColor, Constants::WINDOW_WIDTH);
+    texture = Window::countTexture(SDL_CreateTextureFromSurface(win->getWindowRenderer(), tempSurface));
     SDL_FreeSurface(tempSurface);
     tempSurface = NULL;
-    if(sprite != NULL) {
-        if(sprite->getDstRect() != NULL) {
-            SDL_Rect dstR = *sprite->getDstRect();
-            delete sprite;
-            sprite = new Sprite(texture);
-            sprite->setDstRect(dstR);
-        }
-        else {
-            delete sprite;
-            sprite = new Sprite(texture);
-        }
-    }
-    else {
-        sprite = new Sprite(texture);
-    }
+
+    //Same place as before, only the texture changed
+    sprite.setSpriteSheet(texture);
 }
 
 void FontSprite::setText(Window *win, const std::string &newText) {
+    if(newText == text) return;
     text = newText;
     createNewFontTexture(win);
 }
 
 void FontSprite::setColor(Window *win, const SDL_Color &color) {
-    *textColor = color;
+    textColor = color;
     createNewFontTexture(win);
 }
 
 void FontSprite::draw(Window *win) const {
-    if(sprite != NULL) {
-        sprite->draw(win);
-    }
+    sprite.draw(win);
 }
 
-Sprite * FontSprite::getSprite() const { return sprite; }
-std::string FontSprite::getText() const { return text; }
-SDL_Color FontSprite::getColor() const  { return *textColor; }
+Sprite * FontSprite::getSprite() { return &sprite; }
+const std::string & FontSprite::getText() const { return text; }
+SDL_Color FontSprite::getColor() const  { return textColor; }
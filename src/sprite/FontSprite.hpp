@@ -1,10 +1,11 @@
 #ifndef FONT_SPRITE_HPP
 #define FONT_SPRITE_HPP
 
+#include <stddef.h>
 #include <string>
 #include <SDL2/SDL_ttf.h>
+#include "Sprite.hpp"
 
-class Sprite;
 class Window;
 struct SDL_Renderer;
 struct SDL_Texture;
@@ -12,24 +13,29 @@ struct SDL_Color;
 
 class FontSprite {
 public:
+    //The font stays open in the Font that made the sprite, the sprite only draws with it
     FontSprite(Window *win, TTF_Font *targetFont, const std::string &newText, const SDL_Color &color);
     ~FontSprite();
 
+    //Font sprites come out of a fixed size pool (Constants::FONT_SPRITE_POOL_SIZE)
+    static void * operator new(size_t size);
+    static void operator delete(void *memory);
+
     void setText(Window *win, const std::string &newText);
     void setColor(Window *win, const SDL_Color &color);
     void draw(Window *win) const;
 
-    std::string getText() const;
+    const std::string & getText() const;
     SDL_Color getColor() const;
-    Sprite * getSprite() const;
+    Sprite * getSprite();
 
 private:
     void createNewFontTexture(Window *win);
 
     std::string text;
     TTF_Font *font;
-    SDL_Color *textColor;
-    Sprite *sprite;
+    SDL_Color textColor;
+    Sprite sprite;
     SDL_Texture *texture;
 };
 
@@ -0,0 +1,70 @@
+#include "GlyphAtlas.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "../game/Window.hpp"
+#include "../util/Constants.hpp"
+#include "../util/Util.hpp"
+
+GlyphAtlas::GlyphAtlas(Window *win, TTF_Font *font) : texture(NULL), lineHeight(TTF_FontHeight(font)) {
+    SDL_Color white = Util::createColor(255, 255, 255, Constants::SPRITE_ALPHA_FULL);
+
+    //Render every glyph and lay them out in rows as wide as the atlas
+    SDL_Surface *rendered[GLYPH_COUNT];
+    int x = 0, y = 0, rowHeight = 0;
+    for(int i = 0; i < GLYPH_COUNT; i++) {
+        rendered[i] = TTF_RenderGlyph_Blended(font, static_cast<Uint16> (FIRST_GLYPH + i), white);
+        glyphs[i] = Util::createRect(0, 0, 0, 0);
+        if(rendered[i] == NULL) continue;
+        if(x + rendered[i]->w > Constants::FONT_ATLAS_WIDTH) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        glyphs[i] = Util::createRect(x, y, rendered[i]->w, rendered[i]->h);
+        x += rendered[i]->w;
+        if(rendered[i]->h > rowHeight) rowHeight = rendered[i]->h;
+    }
+
+    //Copy them into one surface, alpha and all, and make that the texture
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, Constants::FONT_ATLAS_WIDTH, y + rowHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if(atlas == NULL) Util::fatalSDLError("Failed to create the glyph atlas");
+    for(int i = 0; i < GLYPH_COUNT; i++) {
+        if(rendered[i] == NULL) continue;
+        SDL_SetSurfaceBlendMode(rendered[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(rendered[i], NULL, atlas, &glyphs[i]);
+        SDL_FreeSurface(rendered[i]);
+    }
+    texture = Window::countTexture(SDL_CreateTextureFromSurface(win->getWindowRenderer(), atlas));
+    SDL_FreeSurface(atlas);
+    if(texture == NULL) Util::fatalSDLError("Failed to create the glyph atlas texture");
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    Window::destroyTexture(texture);
+    texture = NULL;
+}
+
+void GlyphAtlas::draw(Window *win, const char *text, int x, int y, const SDL_Color &color) const {
+    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+    for(const char *c = text; *c != '\0'; c++) {
+        if(*c < FIRST_GLYPH || *c > LAST_GLYPH) continue;
+        const SDL_Rect &glyph = glyphs[*c - FIRST_GLYPH];
+        if(*c != ' ' && glyph.w > 0) {
+            SDL_Rect dst = Util::createRect(x, y, glyph.w, glyph.h);
+            win->drawTexture(texture, &glyph, &dst);
+        }
+        x += glyph.w;
+    }
+}
+
+int GlyphAtlas::getTextWidth(const char *text) const {
+    int width = 0;
+    for(const char *c = text; *c != '\0'; c++) {
+        if(*c >= FIRST_GLYPH && *c <= LAST_GLYPH) width += glyphs[*c - FIRST_GLYPH].w;
+    }
+    return width;
+}
+
+int GlyphAtlas::getLineHeight() const { return lineHeight; }
@@ -0,0 +1,40 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <SDL2/SDL_rect.h>
+#include <SDL2/SDL_ttf.h>
+
+class Window;
+struct SDL_Texture;
+struct SDL_Color;
+
+/**
+ * Every printable ASCII character of a font, rendered once into a single texture
+ * For text that changes every frame (ie: numbers), drawing it is one copy per character out of the same texture
+ * instead of rendering and uploading a new texture whenever the text changes like a FontSprite does
+ * Main thread only
+ */
+class GlyphAtlas {
+public:
+    //The glyphs are rendered white and tinted when they are drawn
+    GlyphAtlas(Window *win, TTF_Font *font);
+    ~GlyphAtlas();
+
+    //Draw a line of text with its top left corner at x, y, characters the atlas doesn't have are skipped
+    void draw(Window *win, const char *text, int x, int y, const SDL_Color &color) const;
+
+    int getTextWidth(const char *text) const;
+    int getLineHeight() const;
+
+private:
+    enum { FIRST_GLYPH = ' ', LAST_GLYPH = '~', GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1 };
+
+    SDL_Texture *texture;
+    SDL_Rect glyphs[GLYPH_COUNT];
+    int lineHeight;
+
+    GlyphAtlas(const GlyphAtlas &);
+    GlyphAtlas & operator=(const GlyphAtlas &);
+};
+
+#endif
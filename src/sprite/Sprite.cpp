@@ -1,24 +1,36 @@
 #include "Sprite.hpp"
 
 #include "../game/Window.hpp"
-#include <SDL2/SDL_rect.h>
+#include "../util/Constants.hpp"
+#include "../util/ObjectPool.hpp"
 #include <SDL2/SDL_render.h>
 
+static ObjectPool<Sprite> & getPool() {
+    static ObjectPool<Sprite> pool(Constants::SPRITE_POOL_SIZE);
+    return pool;
+}
+
+void * Sprite::operator new(size_t size) { return getPool().allocate(size); }
+void Sprite::operator delete(void *memory) { getPool().free(memory); }
+
 Sprite::Sprite(SDL_Texture *sprSheet) {
     spriteSheet = sprSheet;
-    sourceRect = NULL;
-    destinationRect = NULL;
+    sourceRect.x = 0; sourceRect.y = 0;
+    sourceRect.w = 0; sourceRect.h = 0;
+    destinationRect = sourceRect;
+    hasSource = false;
+    hasDestination = false;
 }
 
 Sprite::Sprite(SDL_Texture *sprSheet,
         int srcX, int srcY, int srcW, int srcH,
         int dstX, int dstY, int dstW, int dstH) : Sprite(sprSheet) {
-    sourceRect = new SDL_Rect;
-    destinationRect = new SDL_Rect;
-    sourceRect->x = srcX; sourceRect->y = srcY;
-    sourceRect->w = srcW, sourceRect->h = srcH;
-    destinationRect->x = dstX; destinationRect->y = dstY;
-    destinationRect->w = dstW; destinationRect->h = dstH;
+    sourceRect.x = srcX; sourceRect.y = srcY;
+    sourceRect.w = srcW, sourceRect.h = srcH;
+    destinationRect.x = dstX; destinationRect.y = dstY;
+    destinationRect.w = dstW; destinationRect.h = dstH;
+    hasSource = true;
+    hasDestination = true;
 }
 
 Sprite::Sprite(SDL_Texture *sprSheet, const SDL_Rect &srcRect, const SDL_Rect &dstRect) 
@@ -29,89 +41,49 @@ Sprite::Sprite(SDL_Texture *sprSheet, const SDL_Rect &srcRect, const SDL_Rect &d
 }
 
 Sprite::~Sprite() {
-    if(sourceRect != NULL) {
-        delete sourceRect;
-        sourceRect = NULL;
-    }
-    if(destinationRect != NULL) {
-        delete destinationRect;
-        destinationRect = NULL;
-    }
     spriteSheet = NULL;
 }
 
 void Sprite::draw(Window *window) const {
     if(window != NULL && spriteSheet != NULL) {
-		window->drawTexture(getTexture(), sourceRect, destinationRect);
+		window->drawTexture(getTexture(), getSrcRect(), getDstRect());
     }
 }
 
-int Sprite::getSrcX() const { return sourceRect == NULL ? 0 : sourceRect->x; }
-int Sprite::getSrcY() const { return sourceRect == NULL ? 0 : sourceRect->y; }
-int Sprite::getSrcW() const { return sourceRect == NULL ? 0 : sourceRect->w; }
-int Sprite::getSrcH() const { return sourceRect == NULL ? 0 : sourceRect->h; }
+int Sprite::getSrcX() const { return sourceRect.x; }
+int Sprite::getSrcY() const { return sourceRect.y; }
+int Sprite::getSrcW() const { return sourceRect.w; }
+int Sprite::getSrcH() const { return sourceRect.h; }
 
-int Sprite::getDstX() const { return destinationRect == NULL ? 0 : destinationRect->x; }
-int Sprite::getDstY() const { return destinationRect == NULL ? 0 : destinationRect->y; }
-int Sprite::getDstW() const { return destinationRect == NULL ? 0 : destinationRect->w; }
-int Sprite::getDstH() const { return destinationRect == NULL ? 0 : destinationRect->h; }
+int Sprite::getDstX() const { return destinationRect.x; }
+int Sprite::getDstY() const { return destinationRect.y; }
+int Sprite::getDstW() const { return destinationRect.w; }
+int Sprite::getDstH() const { return destinationRect.h; }
 
-SDL_Rect * Sprite::getSrcRect() const { return sourceRect; }
-SDL_Rect * Sprite::getDstRect() const { return destinationRect; }
+const SDL_Rect * Sprite::getSrcRect() const { return hasSource ? &sourceRect : NULL; }
+const SDL_Rect * Sprite::getDstRect() const { return hasDestination ? &destinationRect : NULL; }
 SDL_Texture * Sprite::getTexture() const { return spriteSheet; }
 
 void Sprite::setSrcRect(const SDL_Rect &srcRect) {
-    if(sourceRect == NULL) { sourceRect = new SDL_Rect; }
-    sourceRect->x = srcRect.x; sourceRect->y = srcRect.y;
-    sourceRect->w = srcRect.w; sourceRect->h = srcRect.h;
+    sourceRect = srcRect;
+    hasSource = true;
 }
 
 void Sprite::setDstRect(const SDL_Rect &dstRect) {
-    if(destinationRect == NULL) { destinationRect = new SDL_Rect; }
-    destinationRect->x = dstRect.x; destinationRect->y = dstRect.y;
-    destinationRect->w = dstRect.w; destinationRect->h = dstRect.h;
+    destinationRect = dstRect;
+    hasDestination = true;
 }
 
-void Sprite::setSrcX(int srcX) {
-    if(sourceRect == NULL) { initRect(sourceRect); }
-    sourceRect->x = srcX;
-}
-void Sprite::setSrcY(int srcY) {
-    if(sourceRect == NULL) { initRect(sourceRect); }
-    sourceRect->y = srcY;
-}
-void Sprite::setSrcW(int srcW) {
-    if(sourceRect == NULL) { initRect(sourceRect); }
-    sourceRect->w = srcW;
-}
-void Sprite::setSrcH(int srcH) {
-    if(sourceRect == NULL) { initRect(sourceRect); }
-    sourceRect->h = srcH;
-}
+void Sprite::setSrcX(int srcX) { sourceRect.x = srcX; hasSource = true; }
+void Sprite::setSrcY(int srcY) { sourceRect.y = srcY; hasSource = true; }
+void Sprite::setSrcW(int srcW) { sourceRect.w = srcW; hasSource = true; }
+void Sprite::setSrcH(int srcH) { sourceRect.h = srcH; hasSource = true; }
 
-void Sprite::setDstX(int dstX) {
-    if(destinationRect == NULL) { initRect(destinationRect); }
-    destinationRect->x = dstX;
-}
-void Sprite::setDstY(int dstY) {
-    if(destinationRect == NULL) { initRect(destinationRect); }
-    destinationRect->y = dstY;
-}
-void Sprite::setDstW(int dstW) {
-    if(destinationRect == NULL) { initRect(destinationRect); }
-    destinationRect->w = dstW;
-}
-void Sprite::setDstH(int dstH) {
-    if(destinationRect == NULL) { initRect(destinationRect); }
-    destinationRect->h = dstH;
-}
+void Sprite::setDstX(int dstX) { destinationRect.x = dstX; hasDestination = true; }
+void Sprite::setDstY(int dstY) { destinationRect.y = dstY; hasDestination = true; }
+void Sprite::setDstW(int dstW) { destinationRect.w = dstW; hasDestination = true; }
+void Sprite::setDstH(int dstH) { destinationRect.h = dstH; hasDestination = true; }
 
 void Sprite::setSpriteSheet(SDL_Texture *newSpriteSheet) {
     spriteSheet = newSpriteSheet;
 }
-
-void Sprite::initRect(SDL_Rect *&targetRect) const {
-    if(targetRect == NULL) targetRect = new SDL_Rect;
-    targetRect->x = 0; targetRect->y = 0;
-    targetRect->w = 0; targetRect->h = 0;
-}
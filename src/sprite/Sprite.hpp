@@ -1,10 +1,12 @@
 #ifndef SPRITE_HPP
 #define SPRITE_HPP
 
+#include <stddef.h>
+#include <SDL2/SDL_rect.h>
+
 class Window;
 struct SDL_Texture;
 struct SDL_Renderer;
-struct SDL_Rect;
 
 class Sprite {
 public:
@@ -29,17 +31,20 @@ public:
             const SDL_Rect &srcRect,
             const SDL_Rect &dstRect);
 
-    /* Destructor -> will not delete the SDL_Texture 
-     * Just delete the dimension rects if they are not NULL */
+    /* Destructor -> will not delete the SDL_Texture */
     ~Sprite();
 
+    /* Sprites come out of a fixed size pool (Constants::SPRITE_POOL_SIZE) */
+    static void * operator new(size_t size);
+    static void operator delete(void *memory);
+
     /* Draw the Sprite to the screen */
     void draw(Window *win) const;
 
     /*
      * Getters and Setters for dimension rects
-     * getters: if dimension rects are null, default return val is -1
-     * setters: if dimension rects are null, will make a new rect but set all to 0 
+     * getters: if a dimension rect is not set, default return val is 0
+     * setters: if a dimension rect is not set, it is set to all 0 first
      */
     int getDstX() const;
     int getDstY() const;
@@ -61,8 +66,9 @@ public:
     void setSrcW(int srcW);
     void setSrcH(int srcH);
 
-    SDL_Rect * getSrcRect() const;
-    SDL_Rect * getDstRect() const;
+    //NULL while the rect is not set
+    const SDL_Rect * getSrcRect() const;
+    const SDL_Rect * getDstRect() const;
     SDL_Texture * getTexture() const;
 
     void setSrcRect(const SDL_Rect &srcRect);
@@ -74,11 +80,10 @@ public:
      */
 
 private:
-    void initRect(SDL_Rect *&targetRect) const;
-
     SDL_Texture *spriteSheet;
-    SDL_Rect *sourceRect;
-    SDL_Rect *destinationRect;
+    SDL_Rect sourceRect;
+    SDL_Rect destinationRect;
+    bool hasSource, hasDestination;
 };
 
 #endif
@@ -3,10 +3,22 @@
 #include "Sprite.hpp"
 #include <SDL2/SDL_render.h>
 #include <SDL2/SDL_image.h>
+#include "../game/Window.hpp"
 #include "../util/Util.hpp"
+#include "../util/Trace.hpp"
 
 SpriteSheet::SpriteSheet(SDL_Renderer *renderer, const char *pathToImage) {
-    sheet = IMG_LoadTexture(renderer, pathToImage);
+    TRACE_SCOPE("SpriteSheet::SpriteSheet");
+    sheet = Window::countTexture(IMG_LoadTexture(renderer, pathToImage));
+    if(sheet == NULL) {
+        std::string message = "Failed to load image: ";
+        Util::fatalSDLError((message + pathToImage).c_str());
+    }
+}
+
+SpriteSheet::SpriteSheet(SDL_Renderer *renderer, SDL_Surface *image, const char *pathToImage) {
+    TRACE_SCOPE("SpriteSheet::SpriteSheet");
+    sheet = Window::countTexture(SDL_CreateTextureFromSurface(renderer, image));
     if(sheet == NULL) {
         std::string message = "Failed to load image: ";
         Util::fatalSDLError((message + pathToImage).c_str());
@@ -14,7 +26,7 @@ SpriteSheet::SpriteSheet(SDL_Renderer *renderer, const char *pathToImage) {
 }
 
 SpriteSheet::~SpriteSheet() {
-    SDL_DestroyTexture(sheet);
+    Window::destroyTexture(sheet);
     sheet = NULL;
 }
 
@@ -30,3 +42,5 @@ Sprite * SpriteSheet::createSprite(int srcX, int srcY, int srcW, int srcH,
 Sprite * SpriteSheet::createSprite(const SDL_Rect &srcRect, const SDL_Rect &dstRect) const {
     return new Sprite(sheet, srcRect, dstRect);
 }
+
+SDL_Texture * SpriteSheet::getTexture() const { return sheet; }
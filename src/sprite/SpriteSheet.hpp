@@ -7,12 +7,16 @@ class Sprite;
 struct SDL_Texture;
 struct SDL_Rect;
 struct SDL_Renderer;
+struct SDL_Surface;
 
 class SpriteSheet {
 public:
 
     /* Create a sprite sheet from a path to an image */
     SpriteSheet(SDL_Renderer *renderer, const char *pathToImage);
+
+    /* Create a sprite sheet from an image that was already loaded, the surface is not kept */
+    SpriteSheet(SDL_Renderer *renderer, SDL_Surface *image, const char *pathToImage);
     ~SpriteSheet();
 
     /* Create Sprites from the SpriteSheet 
@@ -22,6 +26,9 @@ public:
             int dstX, int dstY, int dstW, int dstH) const;
     Sprite * createSprite(const SDL_Rect &srcRect, const SDL_Rect &dstRect) const;
 
+    /* The whole sheet, for drawing many small pieces of it (ie: map tiles) */
+    SDL_Texture * getTexture() const;
+
 private:
     SDL_Texture *sheet;
     std::string sheetName;
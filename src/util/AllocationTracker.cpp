@@ -0,0 +1,161 @@
+#include "AllocationTracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <SDL2/SDL_log.h>
+#include "Util.hpp"
+
+static const char * const TAG_NAMES[ALLOCATION_TAG_COUNT] = {
+	"other",
+	"world",
+	"render",
+	"map",
+	"text",
+	"loader"
+};
+
+//The frame being counted, every thread adds to it
+static std::atomic<unsigned long long> frameAllocations[ALLOCATION_TAG_COUNT];
+static std::atomic<unsigned long long> frameBytes[ALLOCATION_TAG_COUNT];
+static std::atomic<unsigned long long> frameFrees;
+
+//The tag this thread counts towards, counting is off while the tracker logs its own reports
+static thread_local int currentTag = ALLOCATION_OTHER;
+static thread_local bool counting = true;
+
+bool AllocationTracker::logFrames = false;
+bool AllocationTracker::assertSteadyState = false;
+unsigned long long AllocationTracker::frames = 0;
+unsigned long long AllocationTracker::steadyFrames = 0;
+unsigned long long AllocationTracker::allocatingSteadyFrames = 0;
+unsigned long long AllocationTracker::worstFrame = 0;
+FrameAllocations AllocationTracker::lastFrame = {};
+FrameAllocations AllocationTracker::worst = {};
+FrameAllocations AllocationTracker::totals = {};
+
+unsigned long long FrameAllocations::getTotalAllocations() const {
+	unsigned long long total = 0;
+	for (unsigned int i = 0; i < ALLOCATION_TAG_COUNT; i++) total += allocations[i];
+	return total;
+}
+
+unsigned long long FrameAllocations::getTotalBytes() const {
+	unsigned long long total = 0;
+	for (unsigned int i = 0; i < ALLOCATION_TAG_COUNT; i++) total += bytes[i];
+	return total;
+}
+
+bool AllocationTracker::isAvailable() {
+#ifdef GAME_TRACK_ALLOCATIONS
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AllocationTracker::setLogFrames(bool log) { logFrames = log; }
+
+void AllocationTracker::setAssertSteadyState(bool fatal) { assertSteadyState = fatal; }
+
+void AllocationTracker::countAllocation(unsigned long long size) {
+	if (!counting) return;
+	frameAllocations[currentTag].fetch_add(1, std::memory_order_relaxed);
+	frameBytes[currentTag].fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::countFree() {
+	if (counting) frameFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocationTracker::endFrame(bool steadyState) {
+	FrameAllocations counts;
+	for (unsigned int i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+		counts.allocations[i] = frameAllocations[i].exchange(0, std::memory_order_relaxed);
+		counts.bytes[i] = frameBytes[i].exchange(0, std::memory_order_relaxed);
+		totals.allocations[i] += counts.allocations[i];
+		totals.bytes[i] += counts.bytes[i];
+	}
+	counts.frees = frameFrees.exchange(0, std::memory_order_relaxed);
+	totals.frees += counts.frees;
+	lastFrame = counts;
+	frames++;
+
+	unsigned long long allocated = counts.getTotalAllocations();
+	if (allocated > worst.getTotalAllocations()) {
+		worst = counts;
+		worstFrame = frames;
+	}
+	if (steadyState) steadyFrames++;
+	if (steadyState && allocated > 0) allocatingSteadyFrames++;
+	if (allocated == 0) return;
+
+	//Reporting allocates too, that isn't the next frame's doing
+	counting = false;
+	bool fatal = assertSteadyState && steadyState;
+	if (logFrames || fatal) logFrame(steadyState ? "Steady state frame" : "Frame", frames, counts);
+	if (fatal) Util::fatalError("A steady state frame allocated");
+	counting = true;
+}
+
+const FrameAllocations & AllocationTracker::getLastFrame() { return lastFrame; }
+
+void AllocationTracker::logReport() {
+	counting = false;
+	Util::log(SDL_LOG_PRIORITY_INFO, "Allocations over " + std::to_string(frames) + " frames, " 
+		+ std::to_string(allocatingSteadyFrames) + " of " + std::to_string(steadyFrames) + " steady state frames allocated");
+	logFrame("All frames", frames, totals);
+	if (worstFrame > 0) logFrame("Most allocations in frame", worstFrame, worst);
+	counting = true;
+}
+
+void AllocationTracker::logFrame(const char *title, unsigned long long frame, const FrameAllocations &counts) {
+	std::string message = std::string(title) + " " + std::to_string(frame) + ": " 
+		+ std::to_string(counts.getTotalAllocations()) + " allocations, " 
+		+ std::to_string(counts.getTotalBytes()) + " bytes, " + std::to_string(counts.frees) + " frees";
+	for (unsigned int i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+		if (counts.allocations[i] == 0) continue;
+		message += "\n  " + std::string(TAG_NAMES[i]) + ": " + std::to_string(counts.allocations[i]) 
+			+ " allocations, " + std::to_string(counts.bytes[i]) + " bytes";
+	}
+	Util::log(SDL_LOG_PRIORITY_INFO, message);
+}
+
+#ifdef GAME_TRACK_ALLOCATIONS
+
+AllocationScope::AllocationScope(AllocationTag tag) : previous(static_cast<AllocationTag> (currentTag)) { currentTag = tag; }
+
+AllocationScope::~AllocationScope() { currentTag = previous; }
+
+/* The global allocation functions, every new and delete in the game (and the standard library) goes through these */
+
+void * operator new(size_t size) {
+	AllocationTracker::countAllocation(size);
+	void *memory = malloc(size == 0 ? 1 : size);
+	if (memory == NULL) throw std::bad_alloc();
+	return memory;
+}
+
+void * operator new[](size_t size) { return operator new(size); }
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept {
+	AllocationTracker::countAllocation(size);
+	return malloc(size == 0 ? 1 : size);
+}
+
+void * operator new[](size_t size, const std::nothrow_t &) noexcept { return operator new(size, std::nothrow); }
+
+void operator delete(void *memory) noexcept {
+	if (memory == NULL) return;
+	AllocationTracker::countFree();
+	free(memory);
+}
+
+void operator delete[](void *memory) noexcept { operator delete(memory); }
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept { operator delete(memory); }
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { operator delete(memory); }
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+/**
+ * Counts heap allocations frame by frame, split by the subsystem that made them
+ * Only in builds with GAME_TRACK_ALLOCATIONS defined (make game-alloc), they replace the global operator new and delete
+ * Without it the scopes are empty and nothing is counted
+ * Allocations from every thread count towards the frame the main thread is on, in the scope of the thread making them
+ */
+
+enum AllocationTag {
+	ALLOCATION_OTHER,
+	ALLOCATION_WORLD,
+	ALLOCATION_RENDER,
+	ALLOCATION_MAP,
+	ALLOCATION_TEXT,
+	ALLOCATION_LOADER,
+	ALLOCATION_TAG_COUNT
+};
+
+typedef struct FrameAllocations {
+	unsigned long long allocations[ALLOCATION_TAG_COUNT];
+	unsigned long long bytes[ALLOCATION_TAG_COUNT];
+	unsigned long long frees;
+
+	unsigned long long getTotalAllocations() const;
+	unsigned long long getTotalBytes() const;
+} FrameAllocations;
+
+class AllocationTracker {
+public:
+	//Tells if this build counts allocations at all
+	static bool isAvailable();
+
+	//Log every frame that allocates
+	static void setLogFrames(bool log);
+
+	//End the game when a steady state frame allocates
+	static void setAssertSteadyState(bool fatal);
+
+	//Main thread, once a frame (or a headless step) is done
+	//Steady state frames (nothing loading, no screen changing) should not allocate
+	static void endFrame(bool steadyState);
+
+	//What the last frame allocated
+	static const FrameAllocations & getLastFrame();
+
+	//Log the totals over every frame and the frame that allocated the most
+	static void logReport();
+
+	//From the allocation functions
+	static void countAllocation(unsigned long long size);
+	static void countFree();
+
+private:
+	static bool logFrames, assertSteadyState;
+	static unsigned long long frames, steadyFrames, allocatingSteadyFrames, worstFrame;
+	static FrameAllocations lastFrame, worst, totals;
+	static void logFrame(const char *title, unsigned long long frame, const FrameAllocations &counts);
+};
+
+//Allocations made on this thread for the rest of the scope count towards the tag
+class AllocationScope {
+public:
+#ifdef GAME_TRACK_ALLOCATIONS
+	AllocationScope(AllocationTag tag);
+	~AllocationScope();
+
+private:
+	AllocationTag previous;
+#else
+	AllocationScope(AllocationTag) {}
+#endif
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "Arena.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include "Util.hpp"
+
+Arena::Arena(size_t size) : chunkSize(size), chunks(NULL), cursor(NULL), end(NULL), used(0), reserved(0) {}
+
+Arena::~Arena() {
+	while (chunks != NULL) {
+		Chunk *next = chunks->next;
+		free(chunks);
+		chunks = next;
+	}
+}
+
+void * Arena::allocate(size_t size, size_t alignment) {
+	uintptr_t aligned = (reinterpret_cast<uintptr_t> (cursor) + alignment - 1) & ~(static_cast<uintptr_t> (alignment) - 1);
+	if (cursor == NULL || aligned + size > reinterpret_cast<uintptr_t> (end)) {
+		addChunk(size + alignment);
+		aligned = (reinterpret_cast<uintptr_t> (cursor) + alignment - 1) & ~(static_cast<uintptr_t> (alignment) - 1);
+	}
+	char *memory = reinterpret_cast<char *> (aligned);
+	used += memory + size - cursor;
+	cursor = memory + size;
+	return memory;
+}
+
+char * Arena::copyString(const char *string) {
+	size_t length = strlen(string) + 1;
+	char *copy = allocateArray<char>(length);
+	memcpy(copy, string, length);
+	return copy;
+}
+
+void Arena::reset() {
+	if (chunks == NULL) return;
+
+	//The newest chunk is at the front, the first one (a normal sized one) at the back
+	while (chunks->next != NULL) {
+		Chunk *next = chunks->next;
+		reserved -= chunks->size;
+		free(chunks);
+		chunks = next;
+	}
+	cursor = reinterpret_cast<char *> (chunks + 1);
+	end = cursor + chunks->size;
+	used = 0;
+}
+
+size_t Arena::getBytesUsed() const { return used; }
+size_t Arena::getBytesReserved() const { return reserved; }
+
+void Arena::addChunk(size_t minimumSize) {
+	size_t size = minimumSize > chunkSize ? minimumSize : chunkSize;
+	Chunk *chunk = static_cast<Chunk *> (malloc(sizeof(Chunk) + size));
+	if (chunk == NULL) Util::fatalError("Out of memory for an arena");
+	chunk->next = chunks;
+	chunk->size = size;
+	chunks = chunk;
+	cursor = reinterpret_cast<char *> (chunk + 1);
+	end = cursor + size;
+	reserved += size;
+}
@@ -0,0 +1,80 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+/**
+ * Linear (bump) allocator
+ * Memory comes out of big chunks one allocation after the other and is only ever given back all at once,
+ * by resetting or deleting the arena, so loading thousands of little things costs a handful of mallocs
+ * Destructors are NOT called, only put things in here that don't need them (or call them yourself)
+ * Not thread safe, every thread loading something uses its own arena
+ */
+
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+class Arena {
+public:
+	//Allocations bigger than a chunk get a chunk of their own
+	Arena(size_t chunkSize);
+	~Arena();
+
+	void * allocate(size_t size, size_t alignment = alignof(long double));
+
+	//Uninitialised, for plain data
+	template <typename T>
+	T * allocateArray(size_t count) { return static_cast<T *> (allocate(sizeof(T) * count, alignof(T))); }
+
+	template <typename T, typename... Args>
+	T * create(Args&&... args) { return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); }
+
+	//Null terminated copy
+	char * copyString(const char *string);
+
+	//Free everything at once, the first chunk is kept for the next load
+	void reset();
+
+	size_t getBytesUsed() const;
+	size_t getBytesReserved() const;
+
+private:
+	typedef struct Chunk {
+		Chunk *next;
+		size_t size;
+	} Chunk;
+
+	size_t chunkSize;
+	Chunk *chunks;
+	char *cursor, *end;
+	size_t used, reserved;
+
+	Arena(const Arena &);
+	Arena & operator=(const Arena &);
+	void addChunk(size_t minimumSize);
+};
+
+/**
+ * Lets standard containers and strings live in an arena
+ * Deallocating does nothing, the memory comes back when the arena is reset
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+	typedef T value_type;
+
+	ArenaAllocator(Arena *a) : arena(a) {}
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+	T * allocate(size_t count) { return arena->allocateArray<T>(count); }
+	void deallocate(T *, size_t) {}
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U> &other) const { return arena == other.arena; }
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.arena; }
+
+	Arena *arena;
+};
+
+#endif
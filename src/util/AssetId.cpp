@@ -0,0 +1,17 @@
+#include "AssetId.hpp"
+
+#include <cstring>
+#include "Util.hpp"
+
+constexpr uint64_t AssetId::FNV_OFFSET;
+constexpr uint64_t AssetId::FNV_PRIME;
+
+void AssetId::checkCollision(const AssetId &id, const char *name, const char *otherName) {
+#ifndef NDEBUG
+	if (name == NULL || otherName == NULL || strcmp(name, otherName) == 0) return;
+	Util::fatalError(("Asset names " + std::string(name) + " and " + std::string(otherName) 
+		+ " have the same id " + std::to_string(id.getHash())).c_str());
+#else
+	(void) id; (void) name; (void) otherName;
+#endif
+}
@@ -0,0 +1,83 @@
+#ifndef ASSET_ID_HPP
+#define ASSET_ID_HPP
+
+/**
+ * Names assets (images, fonts, maps) by a 64 bit FNV-1a hash of their file name
+ * "NPC 01.png"_asset is hashed by the compiler, ids kept in constants cost nothing to make or to compare
+ * Ids made from strings at run time (ie: file names while loading) hash the string once, without allocating
+ * In debug builds (no NDEBUG) literal ids remember their name so the tables can catch two names with the same hash
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class AssetId {
+public:
+	//The empty id, no asset has it
+	constexpr AssetId() : hash(0)
+#ifndef NDEBUG
+		, name(NULL)
+#endif
+		{}
+
+	explicit constexpr AssetId(const char *fileName) : hash(nonZero(hashString(fileName, FNV_OFFSET)))
+#ifndef NDEBUG
+		, name(NULL)
+#endif
+		{}
+
+	explicit AssetId(const std::string &fileName) : hash(nonZero(hashString(fileName.c_str(), fileName.size(), FNV_OFFSET)))
+#ifndef NDEBUG
+		, name(NULL)
+#endif
+		{}
+
+	constexpr uint64_t getHash() const { return hash; }
+	constexpr bool isEmpty() const { return hash == 0; }
+
+	//The literal the id was made from, NULL for ids made at run time and in release builds
+	const char * getName() const {
+#ifndef NDEBUG
+		return name;
+#else
+		return NULL;
+#endif
+	}
+
+	constexpr bool operator==(const AssetId &other) const { return hash == other.hash; }
+	constexpr bool operator!=(const AssetId &other) const { return hash != other.hash; }
+
+	//Debug builds end the game when two different names have the same id
+	static void checkCollision(const AssetId &id, const char *name, const char *otherName);
+
+private:
+	friend constexpr AssetId operator"" _asset(const char *, size_t);
+
+	static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+	static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+	uint64_t hash;
+#ifndef NDEBUG
+	const char *name;
+#endif
+
+	constexpr AssetId(const char *literal, size_t length) : hash(nonZero(hashString(literal, length, FNV_OFFSET)))
+#ifndef NDEBUG
+		, name(literal)
+#endif
+		{}
+
+	//0 is the empty id
+	static constexpr uint64_t nonZero(uint64_t value) { return value == 0 ? 1 : value; }
+	static constexpr uint64_t hashString(const char *string, uint64_t value) {
+		return *string == '\0' ? value : hashString(string + 1, (value ^ static_cast<uint8_t> (*string)) * FNV_PRIME);
+	}
+	static constexpr uint64_t hashString(const char *string, size_t length, uint64_t value) {
+		return length == 0 ? value : hashString(string + 1, length - 1, (value ^ static_cast<uint8_t> (*string)) * FNV_PRIME);
+	}
+};
+
+constexpr AssetId operator"" _asset(const char *literal, size_t length) { return AssetId(literal, length); }
+
+#endif
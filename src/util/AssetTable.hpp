@@ -0,0 +1,116 @@
+#ifndef ASSET_TABLE_HPP
+#define ASSET_TABLE_HPP
+
+/**
+ * Flat hash table from asset ids to values (open addressing, linear probing)
+ * The id is already a hash, finding an asset is a mask and usually one probe, nothing is allocated
+ * The table grows (and moves its values) when it gets half full, don't keep pointers into it while adding
+ * Not thread safe, whoever owns the table guards it
+ */
+
+#include <vector>
+#include <string>
+#include "AssetId.hpp"
+
+template <typename V>
+class AssetTable {
+public:
+	//The capacity is rounded up to a power of two
+	AssetTable(unsigned int initialCapacity = 16) : count(0) { reserve(initialCapacity); }
+
+	//The name is only kept in debug builds, to catch names with the same id
+	//Returns false (and leaves the value alone) if the id is in the table already
+	bool insert(const AssetId &id, const char *name, const V &value) {
+		if (id.isEmpty()) return false;
+		if ((count + 1) * 2 > keys.size()) reserve(keys.size() * 2);
+		unsigned int slot = probe(id);
+		if (keys[slot] == id.getHash()) {
+#ifndef NDEBUG
+			AssetId::checkCollision(id, names[slot].c_str(), name);
+#endif
+			return false;
+		}
+		keys[slot] = id.getHash();
+		values[slot] = value;
+#ifndef NDEBUG
+		names[slot] = name == NULL ? "" : name;
+#endif
+		count++;
+		return true;
+	}
+
+	//NULL if the id isn't in the table
+	V * find(const AssetId &id) {
+		if (id.isEmpty()) return NULL;
+		unsigned int slot = probe(id);
+		if (keys[slot] != id.getHash()) return NULL;
+#ifndef NDEBUG
+		AssetId::checkCollision(id, names[slot].c_str(), id.getName());
+#endif
+		return &values[slot];
+	}
+	const V * find(const AssetId &id) const { return const_cast<AssetTable *> (this)->find(id); }
+
+	//Visit every value, in no particular order
+	template <typename F>
+	void forEach(const F &visit) {
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			if (keys[i] != 0) visit(values[i]);
+		}
+	}
+
+	void clear() {
+		keys.assign(keys.size(), 0);
+		values.assign(values.size(), V());
+#ifndef NDEBUG
+		names.assign(names.size(), std::string());
+#endif
+		count = 0;
+	}
+
+	unsigned int size() const { return count; }
+
+private:
+	std::vector<uint64_t> keys;
+	std::vector<V> values;
+#ifndef NDEBUG
+	std::vector<std::string> names;
+#endif
+	unsigned int count;
+
+	//The slot holding the id, or the empty slot it would go in
+	unsigned int probe(const AssetId &id) const {
+		unsigned int mask = keys.size() - 1;
+		unsigned int slot = static_cast<unsigned int> (id.getHash()) & mask;
+		while (keys[slot] != 0 && keys[slot] != id.getHash()) slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	void reserve(unsigned int capacity) {
+		unsigned int size = 1;
+		while (size < capacity) size *= 2;
+		if (size <= keys.size()) return;
+
+		std::vector<uint64_t> oldKeys(size, 0);
+		std::vector<V> oldValues(size);
+		oldKeys.swap(keys);
+		oldValues.swap(values);
+#ifndef NDEBUG
+		std::vector<std::string> oldNames(size);
+		oldNames.swap(names);
+#endif
+		for (unsigned int i = 0; i < oldKeys.size(); i++) {
+			if (oldKeys[i] == 0) continue;
+			unsigned int mask = keys.size() - 1;
+			unsigned int slot = static_cast<unsigned int> (oldKeys[i]) & mask;
+			while (keys[slot] != 0) slot = (slot + 1) & mask;
+			keys[slot] = oldKeys[i];
+			values[slot] = oldValues[i];
+#ifndef NDEBUG
+			names[slot].swap(oldNames[i]);
+#endif
+		}
+	}
+};
+
+#endif
@@ -9,15 +9,31 @@ const char * Constants::GAME_TITLE = "Gahoodmon";
 const int Constants::WINDOW_WIDTH = 640;
 const int Constants::WINDOW_HEIGHT = 480;
 const uint32_t Constants::WINDOW_FLAGS = SDL_WINDOW_OPENGL; 
+const unsigned int Constants::WINDOW_RENDER_STATS_FRAMES = 300;
 
 /*
  * GAME CONST */
 const uint8_t Constants::GAME_BACKGROUND_LOOP_DELAY = 25;
-const uint8_t Constants::GAME_LOOP_DELAY = 5;
+const unsigned int Constants::GAME_JOB_WORKERS = 0;
+const unsigned int Constants::GAME_BACKGROUND_TICK_GRAIN = 64;
+const unsigned int Constants::GAME_MAIN_THREAD_JOBS = 1024;
+const unsigned int Constants::GAME_EVENT_QUEUE_SIZE = 256;
+const bool Constants::GAME_SIMULATION_THREAD = true;
+const unsigned int Constants::GAME_INPUT_QUEUE_SIZE = 8;
+const bool Constants::GAME_VSYNC = false;
+const unsigned int Constants::GAME_SPIN_MICROSECONDS = 1500;
+const unsigned int Constants::GAME_LATE_DEADLINE_MICROSECONDS = 1000;
 const uint16_t Constants::TARGET_TICKS_PER_SECOND = 120;
+const unsigned int Constants::GAME_TICK_MICROSECONDS = 1000000 / Constants::TARGET_TICKS_PER_SECOND;
+const unsigned int Constants::GAME_MAX_TICKS_PER_UPDATE = 8;
 const uint8_t Constants::TARGET_FPS = 60;
-const char * const Constants::GAME_THREAD_NAME = "GahoodmonBackgroundThread";
+const char * const Constants::GAME_THREAD_NAME = "GahoodmonJobWorker";
+const char * const Constants::GAME_SIMULATION_THREAD_NAME = "GahoodmonSimulation";
 const char * const Constants::GAME_RES_FOLDER = "../res";
+const unsigned int Constants::GAME_RESOURCE_CHECK_DELAY = 1000;
+const unsigned int Constants::GAME_RESOURCE_GRACE_PERIOD = 10000;
+const unsigned int Constants::GAME_STEADY_STATE_FRAMES = 120;
+const unsigned int Constants::GAME_TRACE_BUFFER_EVENTS = 65536;
 
 /*
  * FILE EXTENSIONS CONST */
@@ -38,26 +54,29 @@ const SDL_Color Constants::COLOR_YELLOW = Util::createColor(255, 255, 0, 255);
 
 /*
  * FONT CONST */
-const char * const Constants::FONT_JOYSTIX = "joystix_monospace.ttf";
+const AssetId Constants::FONT_JOYSTIX = "joystix_monospace.ttf"_asset;
 
 /*
  * IMAGE CONST */
-const char * const Constants::IMAGE_TILESET_UNDERWATER = "tileset_underwater.png";
-const char * const Constants::IMAGE_TILESET_BOAT = "tileset_boat.png";
-const char * const Constants::IMAGE_TILESET_OUTSIDE = "tileset_outside.png";
+const AssetId Constants::IMAGE_TILESET_UNDERWATER = "tileset_underwater.png"_asset;
+const AssetId Constants::IMAGE_TILESET_BOAT = "tileset_boat.png"_asset;
+const AssetId Constants::IMAGE_TILESET_OUTSIDE = "tileset_outside.png"_asset;
 
 /*
  * SPRITE CONST */
 const uint8_t Constants::SPRITE_ALPHA_FULL = 255;
 const uint8_t Constants::SPRITE_ALPHA_NONE = 0;
+const unsigned int Constants::SPRITE_POOL_SIZE = 256;
+const unsigned int Constants::FONT_SPRITE_POOL_SIZE = 32;
+const int Constants::FONT_ATLAS_WIDTH = 512;
 
 /*
  * MAP CONST */
 //maps
-const char * const Constants::MAP_TEST = "test_map.tmx";
-const char * const Constants::MAP_TEST_2 = "test_map2.tmx";
-const char * const Constants::MAP_PALLET_TOWN = "pallet_town.tmx";
-const char * const Constants::MAP_ROUTE_1 = "route_1.tmx";
+const AssetId Constants::MAP_TEST = "test_map.tmx"_asset;
+const AssetId Constants::MAP_TEST_2 = "test_map2.tmx"_asset;
+const AssetId Constants::MAP_PALLET_TOWN = "pallet_town.tmx"_asset;
+const AssetId Constants::MAP_ROUTE_1 = "route_1.tmx"_asset;
 //tile types
 const std::string Constants::TILE_TYPE_FLOOR = "floor";
 const std::string Constants::TILE_TYPE_WALL = "wall";
@@ -67,12 +86,19 @@ const std::string Constants::TILE_TYPE_FLOWER = "flower";
 const std::string Constants::TILE_TYPE_SIGN = "sign";
 const std::string Constants::TILE_TYPE_DOOR = "door";
 const std::string Constants::TILE_TYPE_CLIFF = "cliff";
+//arenas
+const unsigned int Constants::MAP_LOAD_ARENA_SIZE = 256 * 1024;
+const unsigned int Constants::MAP_ARENA_SIZE = 64 * 1024;
+const unsigned int Constants::TILESET_ARENA_SIZE = 16 * 1024;
 
 /*
  * WORLD CONST */
 const int Constants::WORLD_DRAW_WIDTH = 15;
 const int Constants::WORLD_DRAW_HEIGHT = 15;
 const unsigned int Constants::WORLD_MAP_NAME_ANIM_TICK_TIME = 25;
+const unsigned int Constants::WORLD_SCRIPT_BLOCKED_RETRY_TIME = 500;
+const unsigned int Constants::WORLD_CHARACTER_POOL_SIZE = 32;
+const unsigned int Constants::WORLD_TEXT_BOX_POOL_SIZE = 16;
 
 /*
  * CHARACTER CONST */
@@ -83,3 +109,20 @@ const int Constants::CHARACTER_TILE_OFFSET_X = -16;
 const int Constants::CHARACTER_TILE_OFFSET_Y = -16;
 const int Constants::CHARACTER_WALK_SPEED = 2;
 const int Constants::CHARACTER_RUN_SPEED = 4;
+
+/*
+ * PERFORMANCE HUD CONST */
+const unsigned int Constants::PERF_HUD_SAMPLES = 240;
+const unsigned int Constants::PERF_HUD_TEXT_DELAY = 250;
+const int Constants::PERF_HUD_FONT_SIZE = 10;
+const int Constants::PERF_HUD_GRAPH_HEIGHT = 32;
+
+/*
+ * BENCHMARK CONST */
+const unsigned int Constants::BENCH_SAMPLES = 20;
+const unsigned int Constants::BENCH_MIN_SAMPLE_TIME = 2000;
+
+/*
+ * STRESS TEST CONST */
+const unsigned int Constants::STRESS_DEFAULT_SECONDS = 10;
+const unsigned int Constants::STRESS_NPC_SHEETS = 29;
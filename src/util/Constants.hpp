@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <string>
+#include "AssetId.hpp"
 
 struct SDL_Color;
 
@@ -18,6 +19,8 @@ public:
     static const int WINDOW_WIDTH;
     static const int WINDOW_HEIGHT;
     static const uint32_t WINDOW_FLAGS;
+	//Frames the render stats are summarized over
+	static const unsigned int WINDOW_RENDER_STATS_FRAMES;
     /******************
      ******************/
 
@@ -28,11 +31,26 @@ public:
      **********************************
      */
     static const uint8_t GAME_BACKGROUND_LOOP_DELAY;
-    static const uint8_t GAME_LOOP_DELAY;
+    static const unsigned int GAME_JOB_WORKERS;
+    static const unsigned int GAME_BACKGROUND_TICK_GRAIN;
+    static const unsigned int GAME_MAIN_THREAD_JOBS;
+    static const unsigned int GAME_EVENT_QUEUE_SIZE;
+    static const bool GAME_SIMULATION_THREAD;
+    static const unsigned int GAME_INPUT_QUEUE_SIZE;
+    static const bool GAME_VSYNC;
+    static const unsigned int GAME_SPIN_MICROSECONDS;
+    static const unsigned int GAME_LATE_DEADLINE_MICROSECONDS;
 	static const uint16_t TARGET_TICKS_PER_SECOND;
+	static const unsigned int GAME_TICK_MICROSECONDS;
+	static const unsigned int GAME_MAX_TICKS_PER_UPDATE;
     static const uint8_t TARGET_FPS;
     static const char * const GAME_THREAD_NAME;
+    static const char * const GAME_SIMULATION_THREAD_NAME;
     static const char * const GAME_RES_FOLDER;
+    static const unsigned int GAME_RESOURCE_CHECK_DELAY;
+    static const unsigned int GAME_RESOURCE_GRACE_PERIOD;
+    static const unsigned int GAME_STEADY_STATE_FRAMES;
+    static const unsigned int GAME_TRACE_BUFFER_EVENTS;
     /******************
      ******************/
 
@@ -49,12 +67,12 @@ public:
     static const char * const FONT_FILE_EXTENSION;
     
     //Font files
-    static const char * const FONT_JOYSTIX;
+    static const AssetId FONT_JOYSTIX;
     
     //Image files
-    static const char * const IMAGE_TILESET_UNDERWATER;
-    static const char * const IMAGE_TILESET_BOAT;
-    static const char * const IMAGE_TILESET_OUTSIDE;
+    static const AssetId IMAGE_TILESET_UNDERWATER;
+    static const AssetId IMAGE_TILESET_BOAT;
+    static const AssetId IMAGE_TILESET_OUTSIDE;
     /******************
      ******************/
 
@@ -82,6 +100,11 @@ public:
 	//Alpha constants for the sprite
     static const uint8_t SPRITE_ALPHA_FULL;
     static const uint8_t SPRITE_ALPHA_NONE;
+	//How many of each fit in their pool before falling back to the heap
+	static const unsigned int SPRITE_POOL_SIZE;
+	static const unsigned int FONT_SPRITE_POOL_SIZE;
+	//Width in pixels of the texture a glyph atlas lays its characters out in
+	static const int FONT_ATLAS_WIDTH;
 	/******************
 	******************/
     
@@ -91,10 +114,10 @@ public:
      **********************************
      */
 	//Maps
-    static const char * const MAP_TEST;
-    static const char * const MAP_TEST_2;
-    static const char * const MAP_PALLET_TOWN;
-	static const char * const MAP_ROUTE_1;
+    static const AssetId MAP_TEST;
+    static const AssetId MAP_TEST_2;
+    static const AssetId MAP_PALLET_TOWN;
+	static const AssetId MAP_ROUTE_1;
 	//Tile types
     static const std::string TILE_TYPE_FLOOR;
     static const std::string TILE_TYPE_WALL;
@@ -104,6 +127,10 @@ public:
 	static const std::string TILE_TYPE_SIGN;
 	static const std::string TILE_TYPE_DOOR;
 	static const std::string TILE_TYPE_CLIFF;
+	//Arena chunk sizes in bytes: reading one map or tileset file, a loaded map, a loaded tileset
+	static const unsigned int MAP_LOAD_ARENA_SIZE;
+	static const unsigned int MAP_ARENA_SIZE;
+	static const unsigned int TILESET_ARENA_SIZE;
     /******************
 	******************/
     
@@ -115,6 +142,9 @@ public:
     static const int WORLD_DRAW_WIDTH;
     static const int WORLD_DRAW_HEIGHT;
 	static const unsigned int WORLD_MAP_NAME_ANIM_TICK_TIME;
+	static const unsigned int WORLD_SCRIPT_BLOCKED_RETRY_TIME;
+	static const unsigned int WORLD_CHARACTER_POOL_SIZE;
+	static const unsigned int WORLD_TEXT_BOX_POOL_SIZE;
     /******************
 	******************/
     
@@ -133,6 +163,41 @@ public:
     /******************
 	******************/
 
+    /*
+     **********************************
+     * Performance HUD Constants
+     **********************************
+     */
+	//Frames graphed (one pixel each), how often the numbers change (ms), font size and graph height in pixels
+	static const unsigned int PERF_HUD_SAMPLES;
+	static const unsigned int PERF_HUD_TEXT_DELAY;
+	static const int PERF_HUD_FONT_SIZE;
+	static const int PERF_HUD_GRAPH_HEIGHT;
+    /******************
+	******************/
+
+    /*
+     **********************************
+     * Benchmark Constants
+     **********************************
+     */
+	//Samples taken of every benchmark, and how long a sample has to run for (in microseconds) to be worth timing
+	static const unsigned int BENCH_SAMPLES;
+	static const unsigned int BENCH_MIN_SAMPLE_TIME;
+    /******************
+	******************/
+
+    /*
+     **********************************
+     * Stress Test Constants
+     **********************************
+     */
+	//Seconds of game time a crowd stress test runs for when it isn't told, and how many NPC sheets there are to dress the crowd in
+	static const unsigned int STRESS_DEFAULT_SECONDS;
+	static const unsigned int STRESS_NPC_SHEETS;
+    /******************
+	******************/
+
 private:
 	Constants() {}
 	~Constants() {}
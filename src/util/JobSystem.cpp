@@ -0,0 +1,252 @@
+#include "JobSystem.hpp"
+
+#include <thread>
+#include <SDL2/SDL.h>
+#include "Constants.hpp"
+#include "Util.hpp"
+#include "Trace.hpp"
+
+struct Job {
+	JobFunction function;
+	JobCounter *signal;
+	bool mainThread;
+};
+
+//Index of the worker running on this thread, -1 for the main thread and any other thread
+static thread_local int currentWorker = -1;
+
+JobCounter::JobCounter() : pending(0) {}
+
+JobCounter::~JobCounter() {}
+
+bool JobCounter::isDone() const { return pending == 0; }
+
+JobSystem::JobSystem(unsigned int workerCount) 
+	: mainThreadJobs(Constants::GAME_MAIN_THREAD_JOBS),
+	queuedJobs(0), 
+	outstandingJobs(0), 
+	nextWorker(0), 
+	quitting(false),
+	mainThreadId(SDL_ThreadID()) {
+	if (workerCount == 0) {
+		int cores = SDL_GetCPUCount();
+		workerCount = cores > 1 ? static_cast<unsigned int> (cores - 1) : 1;
+	}
+	lock = SDL_CreateMutex();
+	wakeUp = SDL_CreateCond();
+	if (lock == NULL || wakeUp == NULL) Util::fatalSDLError("Failed to create the job system locks");
+
+	//Create every worker before starting any, workers steal from each other
+	for (unsigned int i = 0; i < workerCount; i++) {
+		Worker *worker = new Worker;
+		worker->system = this;
+		worker->index = i;
+		worker->thread = NULL;
+		worker->lock = SDL_CreateMutex();
+		if (worker->lock == NULL) Util::fatalSDLError("Failed to create a job worker lock");
+		workers.push_back(worker);
+	}
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		workers[i]->thread = SDL_CreateThread(runWorker, Constants::GAME_THREAD_NAME, workers[i]);
+		if (workers[i]->thread == NULL) Util::fatalSDLError("Could not create a job worker thread");
+	}
+}
+
+JobSystem::~JobSystem() {
+	waitIdle();
+
+	//Wake every worker up so they see they have to quit
+	SDL_LockMutex(lock);
+	quitting = true;
+	SDL_CondBroadcast(wakeUp);
+	SDL_UnlockMutex(lock);
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		int threadRetVal;
+		SDL_WaitThread(workers[i]->thread, &threadRetVal);
+		SDL_DestroyMutex(workers[i]->lock);
+		delete workers[i];
+		workers[i] = NULL;
+	}
+	workers.clear();
+	SDL_DestroyCond(wakeUp);
+	wakeUp = NULL;
+	SDL_DestroyMutex(lock);
+	lock = NULL;
+}
+
+void JobSystem::submit(const JobFunction &function, JobCounter *signal, JobCounter *dependency) {
+	Job *job = new Job;
+	job->function = function;
+	job->mainThread = false;
+	add(job, signal, dependency);
+}
+
+void JobSystem::submitToMainThread(const JobFunction &function, JobCounter *signal, JobCounter *dependency) {
+	Job *job = new Job;
+	job->function = function;
+	job->mainThread = true;
+	add(job, signal, dependency);
+}
+
+void JobSystem::parallelFor(unsigned int count, unsigned int grainSize, const JobRangeFunction &function) {
+	if (grainSize == 0) grainSize = 1;
+	JobCounter done;
+	for (unsigned int begin = 0; begin < count; begin += grainSize) {
+		unsigned int end = count - begin < grainSize ? count : begin + grainSize;
+		submit([&function, begin, end]() { function(begin, end); }, &done);
+	}
+	wait(&done);
+}
+
+void JobSystem::wait(JobCounter *counter) {
+	while (!counter->isDone()) {
+		if (runOneJob(counter)) continue;
+		if (SDL_ThreadID() == mainThreadId) runMainThreadJobs();
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::waitIdle() {
+	while (outstandingJobs > 0) {
+		if (runOneJob()) continue;
+		if (SDL_ThreadID() == mainThreadId) runMainThreadJobs();
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::runMainThreadJobs() {
+	//At most a queue's worth, jobs that keep queueing more can't keep the main thread here forever
+	mainThreadJobs.drain([this](Job *job) {
+		job->function();
+		finish(job);
+	}, mainThreadJobs.capacity());
+}
+
+unsigned int JobSystem::getWorkerCount() const { return static_cast<unsigned int> (workers.size()); }
+
+void JobSystem::add(Job *job, JobCounter *signal, JobCounter *dependency) {
+	job->signal = signal;
+	if (signal != NULL) signal->pending++;
+	outstandingJobs++;
+
+	//Park the job on its dependency, the last job to finish there will queue it
+	if (dependency != NULL) {
+		SDL_LockMutex(lock);
+		if (!dependency->isDone()) {
+			dependency->waitingJobs.push_back(job);
+			SDL_UnlockMutex(lock);
+			return;
+		}
+		SDL_UnlockMutex(lock);
+	}
+	enqueue(job);
+}
+
+void JobSystem::enqueue(Job *job) {
+	if (job->mainThread) {
+		//Full, the main thread makes room itself, anybody else waits for it to
+		while (!mainThreadJobs.push(job)) {
+			if (SDL_ThreadID() == mainThreadId) runMainThreadJobs();
+			else std::this_thread::yield();
+		}
+		return;
+	}
+
+	//Workers keep their own jobs, everybody else hands them out in turn
+	Worker *worker = currentWorker >= 0 ? workers[currentWorker] : workers[nextWorker++ % workers.size()];
+	SDL_LockMutex(worker->lock);
+	worker->jobs.push_back(job);
+	SDL_UnlockMutex(worker->lock);
+
+	//Counted before taking the lock so a worker going to sleep can't miss it
+	queuedJobs++;
+	SDL_LockMutex(lock);
+	SDL_CondSignal(wakeUp);
+	SDL_UnlockMutex(lock);
+}
+
+//Take the newest (back) or oldest (front) job of a queue, only one counting down the only counter if there is one
+static Job * takeFrom(std::deque<Job *> &jobs, bool newest, JobCounter *only) {
+	if (jobs.empty()) return NULL;
+	if (only == NULL) {
+		Job *job = newest ? jobs.back() : jobs.front();
+		if (newest) jobs.pop_back();
+		else jobs.pop_front();
+		return job;
+	}
+	for (size_t i = 0; i < jobs.size(); i++) {
+		size_t index = newest ? jobs.size() - 1 - i : i;
+		if (jobs[index]->signal != only) continue;
+		Job *job = jobs[index];
+		jobs.erase(jobs.begin() + index);
+		return job;
+	}
+	return NULL;
+}
+
+Job * JobSystem::takeJob(int workerIndex, JobCounter *only) {
+	Job *job = NULL;
+
+	//Newest job of our own first, it is the most likely to still be in the cache
+	if (workerIndex >= 0) {
+		Worker *worker = workers[workerIndex];
+		SDL_LockMutex(worker->lock);
+		job = takeFrom(worker->jobs, true, only);
+		SDL_UnlockMutex(worker->lock);
+	}
+
+	//Then steal the oldest job of somebody else
+	unsigned int start = workerIndex >= 0 ? static_cast<unsigned int> (workerIndex) + 1 : 0;
+	for (unsigned int i = 0; job == NULL && i < workers.size(); i++) {
+		Worker *victim = workers[(start + i) % workers.size()];
+		if (victim->index == static_cast<unsigned int> (workerIndex)) continue;
+		SDL_LockMutex(victim->lock);
+		job = takeFrom(victim->jobs, false, only);
+		SDL_UnlockMutex(victim->lock);
+	}
+	if (job != NULL) queuedJobs--;
+	return job;
+}
+
+bool JobSystem::runOneJob(JobCounter *only) {
+	Job *job = takeJob(currentWorker, only);
+	if (job == NULL) return false;
+	job->function();
+	finish(job);
+	return true;
+}
+
+void JobSystem::finish(Job *job) {
+	JobCounter *signal = job->signal;
+	delete job;
+
+	//Release everything that was waiting on the counter
+	//The waiting jobs are taken before the last count goes, the owner may destroy the counter right after
+	std::vector<Job *> released;
+	if (signal != NULL) {
+		SDL_LockMutex(lock);
+		if (signal->pending == 1) released.swap(signal->waitingJobs);
+		signal->pending--;
+		SDL_UnlockMutex(lock);
+	}
+	for (unsigned int i = 0; i < released.size(); i++) enqueue(released[i]);
+	outstandingJobs--;
+}
+
+int JobSystem::runWorker(void *data) {
+	Worker *worker = static_cast<Worker *> (data);
+	JobSystem *system = worker->system;
+	currentWorker = static_cast<int> (worker->index);
+	TRACE_THREAD(Constants::GAME_THREAD_NAME);
+	while (true) {
+		if (system->runOneJob()) continue;
+		SDL_LockMutex(system->lock);
+		while (!system->quitting && system->queuedJobs == 0) {
+			SDL_CondWait(system->wakeUp, system->lock);
+		}
+		bool quit = system->quitting && system->queuedJobs == 0;
+		SDL_UnlockMutex(system->lock);
+		if (quit) break;
+	}
+	return 0;
+}
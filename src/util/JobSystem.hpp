@@ -0,0 +1,105 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+/**
+ * Work stealing thread pool
+ * Every worker has its own queue, it runs its newest jobs first and steals the oldest jobs
+ * of the other workers when it runs out, so busy workers get help without a shared queue
+ * Jobs are chained together with JobCounters: a job can count one up until it is finished
+ * and wait for another to reach zero before it starts, which builds job graphs
+ * Main thread jobs (ie: anything touching the renderer) go on a lock free queue
+ * and run when the game calls runMainThreadJobs
+ */
+
+#include <stddef.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "MpscQueue.hpp"
+
+struct SDL_Thread;
+struct SDL_mutex;
+struct SDL_cond;
+struct Job;
+
+typedef std::function<void()> JobFunction;
+typedef std::function<void(unsigned int begin, unsigned int end)> JobRangeFunction;
+
+/**
+ * Counts unfinished jobs
+ * Owned by whoever submits the jobs and has to outlive them
+ */
+class JobCounter {
+public:
+	JobCounter();
+	~JobCounter();
+
+	bool isDone() const;
+
+private:
+	friend class JobSystem;
+	std::atomic<int> pending;
+
+	//Jobs that can't start until this counter is done, guarded by the job system lock
+	std::vector<Job *> waitingJobs;
+};
+
+class JobSystem {
+public:
+	//A worker count of 0 uses one worker per core, leaving a core for the main thread
+	JobSystem(unsigned int workerCount);
+
+	//Finishes every submitted job before stopping the workers
+	~JobSystem();
+
+	//Run a job on a worker thread
+	//signal is counted up now and back down when the job is done
+	//dependency has to reach zero before the job starts
+	void submit(const JobFunction &job, JobCounter *signal = NULL, JobCounter *dependency = NULL);
+
+	//Run a job on the main thread during runMainThreadJobs (a continuation)
+	void submitToMainThread(const JobFunction &job, JobCounter *signal = NULL, JobCounter *dependency = NULL);
+
+	//Split [0, count) into ranges of at most grainSize and run them on every core, returns when all are done
+	void parallelFor(unsigned int count, unsigned int grainSize, const JobRangeFunction &job);
+
+	//Help run the counter's own jobs until it reaches zero, other jobs are left to the workers
+	//so a wait (ie: the simulation's, while it holds its lock) never picks up unrelated long work like a preload
+	void wait(JobCounter *counter);
+
+	//Help run jobs until every submitted job is done
+	void waitIdle();
+
+	//Run the jobs waiting for the main thread, should ONLY be called by the main thread
+	void runMainThreadJobs();
+
+	unsigned int getWorkerCount() const;
+
+private:
+	typedef struct Worker {
+		JobSystem *system;
+		unsigned int index;
+		SDL_Thread *thread;
+		SDL_mutex *lock;
+		std::deque<Job *> jobs;
+	} Worker;
+
+	std::vector<Worker *> workers;
+	MpscQueue<Job *> mainThreadJobs;
+	SDL_mutex *lock;
+	SDL_cond *wakeUp;
+	std::atomic<int> queuedJobs, outstandingJobs;
+	std::atomic<unsigned int> nextWorker;
+	std::atomic<bool> quitting;
+	unsigned long mainThreadId;
+
+	void add(Job *job, JobCounter *signal, JobCounter *dependency);
+	void enqueue(Job *job);
+	Job * takeJob(int workerIndex, JobCounter *only);
+	bool runOneJob(JobCounter *only = NULL);
+	void finish(Job *job);
+	static int runWorker(void *worker);
+};
+
+#endif
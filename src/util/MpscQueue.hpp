@@ -0,0 +1,103 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+/**
+ * Bounded multiple producer, single consumer queue
+ * Any thread can push, one thread pops, nobody ever takes a lock or waits for another thread:
+ * a producer claims a slot by moving the tail forward and only tries again if another producer
+ * claimed that slot first, pushing fails straight away when the queue is full
+ * Every slot has a sequence number saying whose turn it is (the producer that claimed it, or the consumer),
+ * so the consumer never reads a slot that is still being written
+ */
+
+#include <atomic>
+#include <vector>
+
+template <typename T>
+class MpscQueue {
+public:
+	//Capacity is rounded up to a power of two
+	MpscQueue(unsigned int capacity) : head(0), tail(0) {
+		unsigned int size = 1;
+		while (size < capacity) size <<= 1;
+		mask = size - 1;
+		slots = std::vector<Slot>(size);
+		for (unsigned int i = 0; i < size; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	~MpscQueue() {}
+
+	//Any thread, false if the queue is full
+	bool push(const T &value) {
+		unsigned int back = tail.load(std::memory_order_relaxed);
+		while (true) {
+			Slot &slot = slots[back & mask];
+			int turn = static_cast<int> (slot.sequence.load(std::memory_order_acquire) - back);
+
+			//The slot is free for this lap, claim it
+			if (turn == 0) {
+				if (tail.compare_exchange_weak(back, back + 1, std::memory_order_relaxed)) {
+					slot.value = value;
+					slot.sequence.store(back + 1, std::memory_order_release);
+					return true;
+				}
+			}
+
+			//The consumer hasn't got to the slot since last lap
+			else if (turn < 0) {
+				return false;
+			}
+
+			//Another producer got there first
+			else {
+				back = tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//Consumer only, false if the queue is empty (or the next value is still being written)
+	bool pop(T &value) {
+		Slot &slot = slots[head & mask];
+		if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+		value = slot.value;
+		slot.sequence.store(head + mask + 1, std::memory_order_release);
+		head++;
+		return true;
+	}
+
+	//Consumer only, hand what is queued (up to max) to handle one at a time, returns how many
+	//Values pushed while draining are handled too, as long as there is room under max
+	template <typename Handler>
+	unsigned int drain(Handler handle, unsigned int max = 0xFFFFFFFF) {
+		unsigned int count = 0;
+		T value;
+		while (count < max && pop(value)) {
+			handle(value);
+			count++;
+		}
+		return count;
+	}
+
+	unsigned int capacity() const { return mask + 1; }
+
+private:
+	static const unsigned int CACHE_LINE = 64;
+
+	typedef struct Slot {
+		std::atomic<unsigned int> sequence;
+		T value;
+
+		Slot() : sequence(0), value() {}
+		Slot(const Slot &other) : sequence(other.sequence.load()), value(other.value) {}
+	} Slot;
+
+	std::vector<Slot> slots;
+	unsigned int mask;
+
+	//Only the consumer touches the head, producers fight over the tail on its own cache line
+	unsigned int head;
+	char beforeTail[CACHE_LINE];
+	std::atomic<unsigned int> tail;
+	char afterTail[CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+/**
+ * Fixed capacity pool of memory for objects of one type, for a class's own operator new and delete
+ * The storage is allocated once, the first time the pool is used, free slots are kept on a free list
+ * so creating and destroying objects in the steady state never touches the heap
+ * A full pool (or a derived class bigger than the type) falls back to the heap, it costs allocations but never fails
+ * Both the simulation and the main thread create objects, the pool is guarded by a spin lock
+ */
+
+#include <stddef.h>
+#include <new>
+#include <atomic>
+
+template <typename T>
+class ObjectPool {
+public:
+	ObjectPool(unsigned int cap) : capacity(cap), storage(NULL), freeList(NULL), used(0) {
+		lock.clear();
+	}
+
+	~ObjectPool() { ::operator delete(storage); }
+
+	void * allocate(size_t size) {
+		if (size == sizeof(T)) {
+			acquire();
+			if (storage == NULL) reserve();
+			Slot *slot = freeList;
+			if (slot != NULL) {
+				freeList = slot->next;
+				used++;
+			}
+			release();
+			if (slot != NULL) return slot;
+		}
+		return ::operator new(size);
+	}
+
+	void free(void *memory) {
+		if (memory == NULL) return;
+		acquire();
+		if (!owns(memory)) {
+			release();
+			::operator delete(memory);
+			return;
+		}
+		Slot *slot = static_cast<Slot *> (memory);
+		slot->next = freeList;
+		freeList = slot;
+		used--;
+		release();
+	}
+
+	unsigned int size() const { return used; }
+	unsigned int getCapacity() const { return capacity; }
+
+private:
+	typedef union Slot {
+		Slot *next;
+		alignas(T) unsigned char object[sizeof(T)];
+	} Slot;
+
+	unsigned int capacity;
+	Slot *storage, *freeList;
+	unsigned int used;
+	std::atomic_flag lock;
+
+	ObjectPool(const ObjectPool &);
+	ObjectPool & operator=(const ObjectPool &);
+
+	void reserve() {
+		storage = static_cast<Slot *> (::operator new(sizeof(Slot) * capacity));
+		for (unsigned int i = capacity; i > 0; i--) {
+			storage[i - 1].next = freeList;
+			freeList = &storage[i - 1];
+		}
+	}
+
+	bool owns(void *memory) const {
+		Slot *slot = static_cast<Slot *> (memory);
+		return storage != NULL && slot >= storage && slot < storage + capacity;
+	}
+
+	void acquire() { while (lock.test_and_set(std::memory_order_acquire)) {} }
+	void release() { lock.clear(std::memory_order_release); }
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef RESOURCE_HANDLE_HPP
+#define RESOURCE_HANDLE_HPP
+
+/**
+ * Reference counted handles to shared assets (sprite sheets, fonts) and the registry that owns them
+ * A handle is a pointer and an atomic count, copying one is cheap and works from any thread
+ * The registry knows every asset by id from the start but only loads it the first time someone asks for it,
+ * an asset nobody holds a handle to for a grace period is unloaded and loads again the next time it is asked for
+ * Loading can take a while (ie: decoding on a worker), a handle tells if its asset is pending, ready or failed
+ */
+
+#include <stddef.h>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <SDL2/SDL_mutex.h>
+#include "AssetTable.hpp"
+
+typedef enum ResourceState {
+	RESOURCE_UNLOADED,
+	RESOURCE_PENDING,
+	RESOURCE_READY,
+	RESOURCE_FAILED
+} ResourceState;
+
+template <typename T>
+struct ResourceEntry {
+	std::string name, path;
+	T *resource;
+	std::atomic<int> references;
+	std::atomic<int> state;
+
+	//When the last handle went away, -1 while someone holds one (guarded by the registry lock)
+	long long unusedSinceUs;
+
+	ResourceEntry(const std::string &n, const std::string &p)
+		: name(n), path(p), resource(NULL), references(0), state(RESOURCE_UNLOADED), unusedSinceUs(-1) {}
+};
+
+template <typename T>
+class ResourceHandle {
+public:
+	ResourceHandle() : entry(NULL) {}
+	explicit ResourceHandle(ResourceEntry<T> *e) : entry(e) { retain(); }
+	ResourceHandle(const ResourceHandle &other) : entry(other.entry) { retain(); }
+	ResourceHandle(ResourceHandle &&other) : entry(other.entry) { other.entry = NULL; }
+	~ResourceHandle() { release(); }
+
+	ResourceHandle & operator=(ResourceHandle other) {
+		std::swap(entry, other.entry);
+		return *this;
+	}
+
+	//NULL until the asset is ready
+	T * get() const { return isReady() ? entry->resource : NULL; }
+	T * operator->() const { return get(); }
+
+	//An empty handle (an asset the registry doesn't know) counts as failed
+	ResourceState getState() const {
+		return entry == NULL ? RESOURCE_FAILED : static_cast<ResourceState> (entry->state.load(std::memory_order_acquire));
+	}
+	bool isReady() const { return getState() == RESOURCE_READY; }
+	bool isPending() const { return getState() == RESOURCE_PENDING; }
+	bool isEmpty() const { return entry == NULL; }
+
+	const std::string & getName() const {
+		static const std::string none;
+		return entry == NULL ? none : entry->name;
+	}
+	const std::string & getPath() const {
+		static const std::string none;
+		return entry == NULL ? none : entry->path;
+	}
+
+	bool operator==(const ResourceHandle &other) const { return entry == other.entry; }
+	bool operator!=(const ResourceHandle &other) const { return entry != other.entry; }
+
+private:
+	ResourceEntry<T> *entry;
+
+	void retain() { if (entry != NULL) entry->references.fetch_add(1, std::memory_order_relaxed); }
+	void release() {
+		if (entry != NULL) entry->references.fetch_sub(1, std::memory_order_release);
+		entry = NULL;
+	}
+};
+
+template <typename T>
+class ResourceRegistry {
+public:
+	ResourceRegistry() : lock(SDL_CreateMutex()) {}
+
+	//Every handle has to be gone by now
+	~ResourceRegistry() {
+		clear();
+		SDL_DestroyMutex(lock);
+	}
+
+	//Make an asset known, it isn't loaded until someone asks for it
+	void add(const std::string &name, const std::string &path) {
+		AssetId id(name);
+		SDL_LockMutex(lock);
+		ResourceEntry<T> **found = entries.find(id);
+		if (found == NULL) entries.insert(id, name.c_str(), new ResourceEntry<T>(name, path));
+		else AssetId::checkCollision(id, (*found)->name.c_str(), name.c_str());
+		SDL_UnlockMutex(lock);
+	}
+
+	//An empty handle if the id isn't known
+	//load comes back true when the asset wasn't loaded, the caller has to load it and call finishLoad
+	ResourceHandle<T> acquire(const AssetId &id, bool &load) {
+		load = false;
+		SDL_LockMutex(lock);
+		ResourceEntry<T> **found = entries.find(id);
+		if (found == NULL) {
+			SDL_UnlockMutex(lock);
+			return ResourceHandle<T>();
+		}
+		ResourceEntry<T> *entry = *found;
+		if (entry->state.load(std::memory_order_relaxed) == RESOURCE_UNLOADED) {
+			entry->state.store(RESOURCE_PENDING, std::memory_order_relaxed);
+			load = true;
+		}
+		ResourceHandle<T> handle(entry);
+		SDL_UnlockMutex(lock);
+		return handle;
+	}
+
+	//The loader is done with an asset acquire asked it to load, NULL when loading failed
+	void finishLoad(const AssetId &id, T *resource) {
+		SDL_LockMutex(lock);
+		ResourceEntry<T> **found = entries.find(id);
+		if (found != NULL && (*found)->state.load(std::memory_order_relaxed) == RESOURCE_PENDING) {
+			(*found)->resource = resource;
+			(*found)->state.store(resource != NULL ? RESOURCE_READY : RESOURCE_FAILED, std::memory_order_release);
+			resource = NULL;
+		}
+		SDL_UnlockMutex(lock);
+		delete resource;
+	}
+
+	//Unload the assets nobody has held a handle to for graceUs, failed ones get to try again
+	//Call it from the thread that may destroy the assets, returns how many were unloaded
+	unsigned int evictUnused(long long nowUs, long long graceUs) {
+		unsigned int evicted = 0;
+		SDL_LockMutex(lock);
+		entries.forEach([nowUs, graceUs, &evicted](ResourceEntry<T> *entry) {
+			int state = entry->state.load(std::memory_order_relaxed);
+			if (state != RESOURCE_READY && state != RESOURCE_FAILED) return;
+			if (entry->references.load(std::memory_order_acquire) > 0) {
+				entry->unusedSinceUs = -1;
+				return;
+			}
+			if (entry->unusedSinceUs < 0) {
+				entry->unusedSinceUs = nowUs;
+				return;
+			}
+			if (nowUs - entry->unusedSinceUs < graceUs) return;
+			entry->state.store(RESOURCE_UNLOADED, std::memory_order_relaxed);
+			delete entry->resource;
+			entry->resource = NULL;
+			entry->unusedSinceUs = -1;
+			if (state == RESOURCE_READY) evicted++;
+		});
+		SDL_UnlockMutex(lock);
+		return evicted;
+	}
+
+	//Delete every asset and forget them all, no handles may be left
+	void clear() {
+		SDL_LockMutex(lock);
+		entries.forEach([](ResourceEntry<T> *entry) {
+			delete entry->resource;
+			delete entry;
+		});
+		entries.clear();
+		SDL_UnlockMutex(lock);
+	}
+
+	unsigned int getLoadedCount() {
+		unsigned int loaded = 0;
+		SDL_LockMutex(lock);
+		entries.forEach([&loaded](ResourceEntry<T> *entry) {
+			if (entry->state.load(std::memory_order_relaxed) == RESOURCE_READY) loaded++;
+		});
+		SDL_UnlockMutex(lock);
+		return loaded;
+	}
+
+private:
+	AssetTable<ResourceEntry<T> *> entries;
+	SDL_mutex *lock;
+
+	ResourceRegistry(const ResourceRegistry &);
+	ResourceRegistry & operator=(const ResourceRegistry &);
+};
+
+#endif
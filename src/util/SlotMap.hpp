@@ -0,0 +1,114 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+/**
+ * Slot map, an unordered container with stable generational handles
+ * Values live packed together in a dense array for fast iteration,
+ * handles point at slots which point into the dense array
+ * Inserting and removing are O(1), removing moves the last value into the hole
+ * Every time a slot is reused its generation goes up, so handles to removed values go stale
+ * and are detected instead of pointing at whatever took their place
+ */
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct SlotHandle {
+	uint32_t index;
+	uint32_t generation;
+
+	bool operator==(const SlotHandle &other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const SlotHandle &other) const { return !(*this == other); }
+} SlotHandle;
+
+//Generation 0 is never handed out, so a zeroed handle is always invalid
+static const SlotHandle INVALID_SLOT_HANDLE = { 0, 0 };
+
+template <typename T>
+class SlotMap {
+public:
+	SlotMap() : freeHead(NO_SLOT) {}
+	~SlotMap() {}
+
+	//Add a value, the handle stays valid until the value is removed
+	SlotHandle insert(const T &value) {
+		uint32_t index;
+		if (freeHead != NO_SLOT) {
+			index = freeHead;
+			freeHead = slots[index].next;
+		}
+		else {
+			index = static_cast<uint32_t> (slots.size());
+			Slot slot = { 0, 0 };
+			slots.push_back(slot);
+		}
+		nextGeneration(slots[index]);
+		slots[index].next = static_cast<uint32_t> (values.size());
+		values.push_back(value);
+		denseToSlot.push_back(index);
+		SlotHandle handle = { index, slots[index].generation };
+		return handle;
+	}
+
+	//Remove a value, returns false for stale handles
+	bool remove(const SlotHandle &handle) {
+		if (!contains(handle)) return false;
+		uint32_t dense = slots[handle.index].next;
+		uint32_t last = static_cast<uint32_t> (values.size()) - 1;
+		if (dense != last) {
+			values[dense] = values[last];
+			denseToSlot[dense] = denseToSlot[last];
+			slots[denseToSlot[dense]].next = dense;
+		}
+		values.pop_back();
+		denseToSlot.pop_back();
+
+		//Bumping the generation makes every handle to this slot stale
+		nextGeneration(slots[handle.index]);
+		slots[handle.index].next = freeHead;
+		freeHead = handle.index;
+		return true;
+	}
+
+	bool contains(const SlotHandle &handle) const {
+		return handle.index < slots.size() 
+			&& handle.generation != 0 
+			&& slots[handle.index].generation == handle.generation;
+	}
+
+	//Get a value by handle, NULL for stale handles
+	T * get(const SlotHandle &handle) { return contains(handle) ? &values[slots[handle.index].next] : NULL; }
+	const T * get(const SlotHandle &handle) const { return contains(handle) ? &values[slots[handle.index].next] : NULL; }
+
+	//Dense access for iteration, order changes when values are removed
+	unsigned int size() const { return static_cast<unsigned int> (values.size()); }
+	T & operator[](unsigned int denseIndex) { return values[denseIndex]; }
+	const T & operator[](unsigned int denseIndex) const { return values[denseIndex]; }
+	SlotHandle getHandle(unsigned int denseIndex) const {
+		SlotHandle handle = { denseToSlot[denseIndex], slots[denseToSlot[denseIndex]].generation };
+		return handle;
+	}
+
+	void clear() {
+		while (!values.empty()) remove(getHandle(size() - 1));
+	}
+
+private:
+	static const uint32_t NO_SLOT = 0xFFFFFFFF;
+
+	//next is the dense index while the slot is used, the next free slot while it is free
+	typedef struct Slot {
+		uint32_t generation;
+		uint32_t next;
+	} Slot;
+
+	static void nextGeneration(Slot &slot) { if (++slot.generation == 0) slot.generation = 1; }
+
+	std::vector<T> values;
+	std::vector<uint32_t> denseToSlot;
+	std::vector<Slot> slots;
+	uint32_t freeHead;
+};
+
+#endif
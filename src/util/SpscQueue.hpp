@@ -0,0 +1,74 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+/**
+ * Bounded single producer, single consumer queue
+ * One thread pushes and one other thread pops, neither ever waits on the other:
+ * pushing fails straight away when the queue is full instead
+ * The producer owns the tail and the consumer owns the head, each only reads the other's index,
+ * and they are padded onto separate cache lines so the two threads don't keep stealing the line from each other
+ */
+
+#include <atomic>
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+public:
+	//Capacity is rounded up to a power of two
+	SpscQueue(unsigned int capacity) : head(0), tail(0) {
+		unsigned int size = 1;
+		while (size < capacity) size <<= 1;
+		mask = size - 1;
+		buffer.resize(size);
+	}
+	~SpscQueue() {}
+
+	//Producer only, false if the queue is full
+	bool push(const T &value) {
+		unsigned int back = tail.load(std::memory_order_relaxed);
+		if (back - head.load(std::memory_order_acquire) > mask) return false;
+		buffer[back & mask] = value;
+		tail.store(back + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Consumer only, false if the queue is empty
+	bool pop(T &value) {
+		unsigned int front = head.load(std::memory_order_relaxed);
+		if (front == tail.load(std::memory_order_acquire)) return false;
+		value = buffer[front & mask];
+		head.store(front + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Consumer only, hand everything queued right now (up to max) to handle, returns how many
+	template <typename Handler>
+	unsigned int drain(Handler handle, unsigned int max = 0xFFFFFFFF) {
+		unsigned int front = head.load(std::memory_order_relaxed);
+		unsigned int back = tail.load(std::memory_order_acquire);
+		unsigned int count = back - front < max ? back - front : max;
+		for (unsigned int i = 0; i < count; i++) handle(buffer[(front + i) & mask]);
+
+		//Free the slots all at once, the producer can't reuse them while they are being handled
+		head.store(front + count, std::memory_order_release);
+		return count;
+	}
+
+	//Only exact while neither side is running
+	unsigned int size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+	unsigned int capacity() const { return mask + 1; }
+
+private:
+	static const unsigned int CACHE_LINE = 64;
+
+	std::vector<T> buffer;
+	unsigned int mask;
+	char beforeHead[CACHE_LINE];
+	std::atomic<unsigned int> head;
+	char beforeTail[CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+	std::atomic<unsigned int> tail;
+	char afterTail[CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+};
+
+#endif
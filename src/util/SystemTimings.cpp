@@ -0,0 +1,60 @@
+#include "SystemTimings.hpp"
+
+#include <string>
+#include <SDL2/SDL_log.h>
+#include "Util.hpp"
+
+static const char * const SYSTEM_NAMES[SYSTEM_COUNT] = {
+	"input",
+	"object ticks",
+	"  movement",
+	"  animation",
+	"  scripts",
+	"snapshots",
+	"background ticks"
+};
+
+bool SystemTimings::enabled = false;
+unsigned long long SystemTimings::totals[SYSTEM_COUNT] = {};
+unsigned int SystemTimings::calls[SYSTEM_COUNT] = {};
+
+void SystemTimings::setEnabled(bool enable) { enabled = enable; }
+
+bool SystemTimings::isEnabled() { return enabled; }
+
+void SystemTimings::reset() {
+	for (unsigned int i = 0; i < SYSTEM_COUNT; i++) {
+		totals[i] = 0;
+		calls[i] = 0;
+	}
+}
+
+void SystemTimings::add(SimulationSystem system, unsigned long long nanoseconds) {
+	totals[system] += nanoseconds;
+	calls[system]++;
+}
+
+void SystemTimings::logReport(unsigned int steps, unsigned long long stepsNanoseconds) {
+	//Movement, animation and scripts run inside the object ticks, they are not added again
+	std::string message = "Simulation timings over " + std::to_string(steps) + " steps:";
+	for (unsigned int i = 0; i < SYSTEM_COUNT; i++) {
+		unsigned long long perStepNs = steps == 0 ? 0 : totals[i] / steps;
+		unsigned long long percent = stepsNanoseconds == 0 ? 0 : totals[i] * 100 / stepsNanoseconds;
+		message += "\n  " + std::string(SYSTEM_NAMES[i]) + ": "
+			+ std::to_string(totals[i] / 1000000) + "ms total, "
+			+ std::to_string(perStepNs) + "ns per step, "
+			+ std::to_string(percent) + "%, "
+			+ std::to_string(calls[i]) + " calls";
+	}
+	Util::log(SDL_LOG_PRIORITY_INFO, message);
+}
+
+SystemTimer::SystemTimer(SimulationSystem timed) : system(timed), timing(SystemTimings::isEnabled()) {
+	if (timing) start = std::chrono::steady_clock::now();
+}
+
+SystemTimer::~SystemTimer() {
+	if (!timing) return;
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+	SystemTimings::add(system, static_cast<unsigned long long> (elapsed.count()));
+}
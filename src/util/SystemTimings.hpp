@@ -0,0 +1,51 @@
+#ifndef SYSTEM_TIMINGS_HPP
+#define SYSTEM_TIMINGS_HPP
+
+/**
+ * Adds up how long every part of a simulation step takes, for benchmarks
+ * Off unless enabled, then every timed part costs two clock reads
+ * Only the simulation thread adds to the totals, read them once it has stopped
+ */
+
+#include <chrono>
+
+enum SimulationSystem {
+	SYSTEM_INPUT,
+	SYSTEM_OBJECT_TICKS,
+	SYSTEM_MOVEMENT,
+	SYSTEM_ANIMATION,
+	SYSTEM_SCRIPTS,
+	SYSTEM_SNAPSHOTS,
+	SYSTEM_BACKGROUND_TICKS,
+	SYSTEM_COUNT
+};
+
+class SystemTimings {
+public:
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+	static void reset();
+	static void add(SimulationSystem system, unsigned long long nanoseconds);
+
+	//Log the totals, per step and as a share of the time the steps took
+	static void logReport(unsigned int steps, unsigned long long stepsNanoseconds);
+
+private:
+	static bool enabled;
+	static unsigned long long totals[SYSTEM_COUNT];
+	static unsigned int calls[SYSTEM_COUNT];
+};
+
+//Times the rest of the scope as one system
+class SystemTimer {
+public:
+	SystemTimer(SimulationSystem system);
+	~SystemTimer();
+
+private:
+	SimulationSystem system;
+	bool timing;
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif
@@ -31,6 +31,18 @@ int Timer::getTargetMs() const {
     return targetMs;
 }
 
+int Timer::getElapsedMicroseconds() {
+    finish = std::chrono::high_resolution_clock::now();
+    return static_cast<int> (std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count());
+}
+
+unsigned int Timer::lapMicroseconds() {
+    finish = std::chrono::high_resolution_clock::now();
+    unsigned int elapsed = static_cast<unsigned int> (std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count());
+    start = finish;
+    return elapsed;
+}
+
 int Timer::getElapsedMs() {
     finish = std::chrono::high_resolution_clock::now();
 	double elapsedTime = std::chrono::duration_cast<std::chrono::duration<double>>(finish - start).count();
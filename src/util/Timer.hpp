@@ -14,6 +14,11 @@ public:
     void setTargetMs(unsigned int);
     int getTargetMs() const;
 	int getElapsedMs();
+
+	int getElapsedMicroseconds();
+
+	//Microseconds since the last reset or lap, restarts the timer without losing any time
+	unsigned int lapMicroseconds();
 private:
     std::chrono::high_resolution_clock::time_point start, finish;
 	unsigned int targetMs;
@@ -0,0 +1,81 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel(unsigned int tickMicroseconds)
+	: tickUs(tickMicroseconds > 0 ? tickMicroseconds : 1),
+	currentTick(0) {}
+
+TimerWheel::~TimerWheel() {}
+
+TimerHandle TimerWheel::schedule(unsigned int delayMicroseconds, const TimerCallback &callback) {
+	unsigned long long delayTicks = (delayMicroseconds + tickUs - 1) / tickUs;
+	if (delayTicks == 0) delayTicks = 1;
+	TimerEntry entry;
+	entry.deadline = currentTick + delayTicks;
+	entry.callback = callback;
+	TimerHandle handle = timers.insert(entry);
+	place(handle, entry.deadline);
+	return handle;
+}
+
+bool TimerWheel::cancel(const TimerHandle &handle) { return timers.remove(handle); }
+
+bool TimerWheel::isScheduled(const TimerHandle &handle) const { return timers.contains(handle); }
+
+void TimerWheel::advance() {
+	currentTick++;
+
+	//Every time a level wraps around, the next slot of the level above moves down
+	for (unsigned int level = 1; level < LEVELS; level++) {
+		if ((currentTick & ((1ULL << (level * SLOT_BITS)) - 1)) != 0) break;
+		cascade(level);
+	}
+
+	//Take the slot first, callbacks can add timers to it for the next time around
+	due.swap(slots[0][currentTick & (SLOTS - 1)]);
+	for (unsigned int i = 0; i < due.size(); i++) {
+		TimerEntry *entry = timers.get(due[i]);
+		if (entry == NULL) continue;
+
+		//Too far away when it was placed, it goes around again
+		if (entry->deadline > currentTick) {
+			place(due[i], entry->deadline);
+			continue;
+		}
+		TimerCallback callback;
+		callback.swap(entry->callback);
+		timers.remove(due[i]);
+		callback();
+	}
+	due.clear();
+}
+
+unsigned long long TimerWheel::getCurrentTick() const { return currentTick; }
+
+unsigned long long TimerWheel::getTimeMicroseconds() const { return currentTick * tickUs; }
+
+unsigned int TimerWheel::getTickMicroseconds() const { return tickUs; }
+
+unsigned int TimerWheel::size() const { return timers.size(); }
+
+void TimerWheel::place(const TimerHandle &handle, unsigned long long deadline) {
+	//Anything past the end of the wheel waits in the furthest slot
+	const unsigned long long wheelTicks = 1ULL << (LEVELS * SLOT_BITS);
+	unsigned long long delay = deadline - currentTick;
+	if (delay >= wheelTicks) {
+		delay = wheelTicks - 1;
+		deadline = currentTick + delay;
+	}
+	unsigned int level = 0;
+	while (level + 1 < LEVELS && delay >= (1ULL << ((level + 1) * SLOT_BITS))) level++;
+	unsigned int slot = static_cast<unsigned int> ((deadline >> (level * SLOT_BITS)) & (SLOTS - 1));
+	slots[level][slot].push_back(handle);
+}
+
+void TimerWheel::cascade(unsigned int level) {
+	cascading.swap(slots[level][(currentTick >> (level * SLOT_BITS)) & (SLOTS - 1)]);
+	for (unsigned int i = 0; i < cascading.size(); i++) {
+		const TimerEntry *entry = timers.get(cascading[i]);
+		if (entry != NULL) place(cascading[i], entry->deadline);
+	}
+	cascading.clear();
+}
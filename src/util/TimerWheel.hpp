@@ -0,0 +1,68 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+/**
+ * Hierarchical timer wheel
+ * Time moves forward in whole ticks (ie: simulation steps) by calling advance, nothing reads a clock
+ * Each level is a ring of slots, a timer goes in the slot of the level that covers how far away it is
+ * and moves down a level every time the level below wraps around, so advancing a tick only
+ * looks at the timers that are due instead of every timer there is
+ * Timers further away than the wheel covers wait in the top level and go back in when they come up
+ */
+
+#include <vector>
+#include <functional>
+#include "SlotMap.hpp"
+
+typedef std::function<void()> TimerCallback;
+typedef SlotHandle TimerHandle;
+
+class TimerWheel {
+public:
+	TimerWheel(unsigned int tickMicroseconds);
+	~TimerWheel();
+
+	//Call the callback once, after at least delayMicroseconds (rounded up to whole ticks, at least one)
+	TimerHandle schedule(unsigned int delayMicroseconds, const TimerCallback &callback);
+
+	//Stop a timer from going off, returns false if it already went off or was cancelled
+	bool cancel(const TimerHandle &handle);
+	bool isScheduled(const TimerHandle &handle) const;
+
+	//Move time forward one tick and call every timer that is due
+	//Callbacks can schedule and cancel timers, anything scheduled now goes off on a later tick
+	void advance();
+
+	unsigned long long getCurrentTick() const;
+	unsigned long long getTimeMicroseconds() const;
+	unsigned int getTickMicroseconds() const;
+
+	//Number of timers waiting to go off
+	unsigned int size() const;
+
+private:
+	static const unsigned int LEVELS = 4;
+	static const unsigned int SLOT_BITS = 6;
+	static const unsigned int SLOTS = 1 << SLOT_BITS;
+
+	typedef struct TimerEntry {
+		unsigned long long deadline;
+		TimerCallback callback;
+	} TimerEntry;
+
+	unsigned int tickUs;
+	unsigned long long currentTick;
+	SlotMap<TimerEntry> timers;
+
+	//Cancelled timers stay in their slot until it comes up, their handle is stale by then
+	std::vector<TimerHandle> slots[LEVELS][SLOTS];
+
+	//A slot is swapped with one of these while its timers go off or move down a level, then it is cleared
+	//The capacity goes back and forth between the slots and these, so re-arming timers never allocates
+	std::vector<TimerHandle> due, cascading;
+
+	void place(const TimerHandle &handle, unsigned long long deadline);
+	void cascade(unsigned int level);
+};
+
+#endif
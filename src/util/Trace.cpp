@@ -0,0 +1,135 @@
+#include "Trace.hpp"
+
+#include <cstdio>
+#include <string>
+#include <SDL2/SDL_rwops.h>
+#include <SDL2/SDL_log.h>
+#include "Constants.hpp"
+#include "Util.hpp"
+
+typedef struct TraceEvent {
+	const char *name;
+	long long beginNs, endNs;
+} TraceEvent;
+
+//One for every thread that recorded something, kept until the program ends so an export can read it at any time
+//Only its thread writes to it, count is published after the event is written
+typedef struct TraceBuffer {
+	std::atomic<unsigned int> count;
+	std::atomic<unsigned int> dropped;
+	const char *threadName;
+	unsigned int threadId;
+	TraceEvent *events;
+	TraceBuffer *next;
+} TraceBuffer;
+
+std::atomic<bool> Trace::enabled(false);
+static std::atomic<TraceBuffer *> buffers(NULL);
+static std::atomic<unsigned int> threads(0);
+static thread_local TraceBuffer *threadBuffer = NULL;
+static thread_local const char *threadName = NULL;
+
+static TraceBuffer * getThreadBuffer() {
+	if (threadBuffer != NULL) return threadBuffer;
+	TraceBuffer *buffer = new TraceBuffer;
+	buffer->count = 0;
+	buffer->dropped = 0;
+	buffer->threadName = threadName;
+	buffer->threadId = ++threads;
+	buffer->events = new TraceEvent[Constants::GAME_TRACE_BUFFER_EVENTS];
+	buffer->next = buffers.load(std::memory_order_relaxed);
+	while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed)) {}
+	threadBuffer = buffer;
+	return buffer;
+}
+
+bool Trace::isAvailable() {
+#ifdef GAME_TRACING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Trace::setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+long long Trace::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::setThreadName(const char *name) {
+	//Threads name themselves before they record anything, the buffer picks the name up when it is made
+	threadName = name;
+}
+
+void Trace::record(const char *name, long long beginNs, long long endNs) {
+	TraceBuffer *buffer = getThreadBuffer();
+	unsigned int index = buffer->count.load(std::memory_order_relaxed);
+	if (index >= Constants::GAME_TRACE_BUFFER_EVENTS) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	TraceEvent &event = buffer->events[index];
+	event.name = name;
+	event.beginNs = beginNs;
+	event.endNs = endNs;
+	buffer->count.store(index + 1, std::memory_order_release);
+}
+
+static void appendString(std::string &json, const char *string) {
+	json += '"';
+	for (const char *c = string; *c != '\0'; c++) {
+		if (*c == '"' || *c == '\\') json += '\\';
+		json += *c;
+	}
+	json += '"';
+}
+
+bool Trace::writeChromeTrace(const char *path) {
+	//The timestamps start at the earliest scope, in microseconds
+	TraceBuffer *first = buffers.load(std::memory_order_acquire);
+	long long startNs = -1;
+	for (TraceBuffer *buffer = first; buffer != NULL; buffer = buffer->next) {
+		unsigned int count = buffer->count.load(std::memory_order_acquire);
+		for (unsigned int i = 0; i < count; i++) {
+			if (startNs < 0 || buffer->events[i].beginNs < startNs) startNs = buffer->events[i].beginNs;
+		}
+	}
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	unsigned int written = 0, dropped = 0;
+	char number[96];
+	for (TraceBuffer *buffer = first; buffer != NULL; buffer = buffer->next) {
+		if (buffer->threadName != NULL) {
+			snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", buffer->threadId);
+			if (json.back() == '}') json += ',';
+			json += number;
+			appendString(json, buffer->threadName);
+			json += "}}";
+		}
+		unsigned int count = buffer->count.load(std::memory_order_acquire);
+		for (unsigned int i = 0; i < count; i++) {
+			const TraceEvent &event = buffer->events[i];
+			if (json.back() == '}') json += ',';
+			json += "{\"name\":";
+			appendString(json, event.name);
+			snprintf(number, sizeof(number), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", 
+				buffer->threadId, (event.beginNs - startNs) / 1000.0, (event.endNs - event.beginNs) / 1000.0);
+			json += number;
+		}
+		written += count;
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	json += "]}\n";
+
+	SDL_RWops *file = SDL_RWFromFile(path, "wb");
+	if (file == NULL) {
+		Util::log(SDL_LOG_PRIORITY_ERROR, std::string("Failed to open the trace file ") + path);
+		return false;
+	}
+	bool saved = SDL_RWwrite(file, json.data(), 1, json.size()) == json.size();
+	SDL_RWclose(file);
+	Util::log(SDL_LOG_PRIORITY_INFO, "Wrote " + std::to_string(written) + " trace scopes to " + path 
+		+ (dropped > 0 ? " (" + std::to_string(dropped) + " dropped, the buffers were full)" : ""));
+	return saved;
+}
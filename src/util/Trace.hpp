@@ -0,0 +1,55 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+/**
+ * Records how long scopes take, on every thread, to look at in chrome://tracing or Perfetto
+ * TRACE_SCOPE("name") times the rest of the scope, TRACE_THREAD("name") names the calling thread in the trace
+ * They only exist in builds with GAME_TRACING defined (make game-trace), otherwise they compile to nothing
+ * Compiled in, nothing is recorded until tracing is enabled and a scope costs one flag check
+ * Every thread writes to its own buffer without locking, a full buffer drops the newest scopes
+ * Names have to be string literals (or live as long as the program)
+ */
+
+#include <atomic>
+#include <chrono>
+
+class Trace {
+public:
+	//Tells if this build has the trace scopes compiled in
+	static bool isAvailable();
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+	//Write everything recorded so far as a Chrome trace (JSON), from any thread, returns false if the file can't be written
+	static bool writeChromeTrace(const char *path);
+
+	static void setThreadName(const char *name);
+	static void record(const char *name, long long beginNs, long long endNs);
+	static long long now();
+
+private:
+	static std::atomic<bool> enabled;
+};
+
+class TraceScope {
+public:
+	TraceScope(const char *scopeName) : name(scopeName), beginNs(Trace::isEnabled() ? Trace::now() : -1) {}
+	~TraceScope() { if (beginNs >= 0) Trace::record(name, beginNs, Trace::now()); }
+
+private:
+	const char *name;
+	long long beginNs;
+};
+
+#ifdef GAME_TRACING
+#define TRACE_CONCAT_LINE(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_LINE(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_THREAD(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_THREAD(name)
+#endif
+
+#endif
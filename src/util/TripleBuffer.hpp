@@ -0,0 +1,45 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+/**
+ * Hands the newest copy of a value from one writer thread to one reader thread
+ * Three copies: the writer fills the back one, the reader draws from the front one
+ * and the middle one is swapped with either side, so neither ever waits for the other
+ * The reader always gets the newest complete copy, copies published in between are skipped
+ */
+
+#include <atomic>
+
+template <typename T>
+class TripleBuffer {
+public:
+	TripleBuffer() : buffers(), back(0), middle(1), front(2) {}
+	~TripleBuffer() {}
+
+	//Writer only, the copy to fill in, it still has what was in it when it was published last
+	T & getBack() { return buffers[back]; }
+
+	//Writer only, hand the back copy over to the reader
+	void publish() { back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+	//Reader only, switch to the newest published copy, false if nothing was published since the last time
+	bool acquire() {
+		if ((middle.load(std::memory_order_acquire) & FRESH) == 0) return false;
+		front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+		return true;
+	}
+
+	//Reader only
+	const T & getFront() const { return buffers[front]; }
+
+private:
+	//The middle index has a bit saying the copy there was published and not acquired yet
+	static const unsigned int INDEX = 3, FRESH = 4;
+
+	T buffers[3];
+	unsigned int back;
+	std::atomic<unsigned int> middle;
+	unsigned int front;
+};
+
+#endif
@@ -2,23 +2,26 @@
 
 #include <SDL2/SDL_log.h>
 #include <SDL2/SDL_rwops.h>
+#include "Trace.hpp"
 
 #define TAG "XMLParser"
 
-static void recursiveDeleteTag(Tag *);
-
-XMLObject * XMLParser::loadXML(const char *file) {
+XMLObject * XMLParser::loadXML(const char *file, Arena *arena) {
+	TRACE_SCOPE("XMLParser::loadXML");
 	SDL_RWops *ctx = SDL_RWFromFile(file, "rb");
 	if (ctx == NULL) {
 		SDL_Log("%s: Failed to load file \"%s\"\n", TAG, file);
 		return NULL;
 	}
-	XMLObject *obj = new XMLObject;
-	char buf[1];
-	buf[0] = '\0';
-	while (SDL_RWread(ctx, buf, sizeof(char), 1)) {
-		obj->fileString += buf[0];
+	XMLObject *obj = arena->create<XMLObject>(arena);
+
+	//The whole file in one read
+	Sint64 size = SDL_RWsize(ctx);
+	if (size > 0) {
+		obj->fileString.resize(static_cast<size_t> (size));
+		obj->fileString.resize(SDL_RWread(ctx, &obj->fileString[0], sizeof(char), obj->fileString.size()));
 	}
+	SDL_RWclose(ctx);
 	generateTags(obj);
 	return obj;
 }
@@ -36,77 +39,13 @@ void XMLParser::generateTags(XMLObject *obj) {
 				}
 				i++; continue;
 			}
-
-			//Get the tag
-			Tag *tag = new Tag;
-
-			//Get the id
-			tag->id = "";
-			while (i < obj->fileString.length()
-				&& obj->fileString[i] != ' '
-				&& obj->fileString[i] != '\n'
-				&& obj->fileString[i] != '\r'
-				&& obj->fileString[i] != '/'
-				&& obj->fileString[i] != '>') {
-				tag->id += obj->fileString[i];
-				i++;
-			}
-
-			//Get attributes and keys
-			while (obj->fileString[i] != '>'
-				&& obj->fileString[i] != '/') {
-
-				//Found an attribute
-				if (obj->fileString[i] != ' '
-					&& obj->fileString[i] != '\n'
-					&& obj->fileString[i] != '\r') {
-					std::string attr = "";
-					std::string key = "";
-					while (obj->fileString[i] != '=') {
-						attr += obj->fileString[i];
-						i++;
-					}
-					i++;
-					while (obj->fileString[i] == ' '
-						|| obj->fileString[i] == '\n'
-						|| obj->fileString[i] == '\r') i++;
-					int numQuotes = 0;
-					while (numQuotes < 2) {
-						if (obj->fileString[i] == '"') {
-							i++;
-							numQuotes++;
-							continue;
-						}
-						key += obj->fileString[i];
-						i++;
-					}
-					tag->attributes.push_back(std::pair<std::string, std::string>(attr, key));
-				}
-				else {
-					i++;
-				}
-				//End found attribute
-
-			}
-
-			//At the end of a tag, check to see if has subtags
-			//Has no subtags
-			if (obj->fileString[i] == '/') {
-				i++;
-			}
-			//Has subtags
-			else {
-				i++;
-				generateTags(tag, obj->fileString, i);
-			}
-
-			obj->tags.push_back(tag);
+			obj->tags.push_back(readTag(obj->arena, obj->fileString, i));
 		}
 		i++;
 	}
 }
 
-void XMLParser::generateTags(Tag *parent, const std::string &fileStr, unsigned int &i) {
+void XMLParser::generateTags(Arena *arena, Tag *parent, const XMLString &fileStr, unsigned int &i) {
 	while (i < fileStr.length()) {
 
 		//Found data
@@ -114,11 +53,9 @@ void XMLParser::generateTags(Tag *parent, const std::string &fileStr, unsigned i
 			&& fileStr[i] != '\n'
 			&& fileStr[i] != '\r'
 			&& fileStr[i] != '<') {
-			parent->data = "";
-			while (fileStr[i] != '<') {
-				parent->data += fileStr[i];
-				i++;
-			}
+			unsigned int dataStart = i;
+			while (fileStr[i] != '<') i++;
+			parent->data.assign(fileStr.data() + dataStart, i - dataStart);
 			while (fileStr[i] != '>') i++;
 			i++;
 			return;
@@ -145,92 +82,61 @@ void XMLParser::generateTags(Tag *parent, const std::string &fileStr, unsigned i
 				i++; 
 				return;
 			}
-
-			//Get the tag
-			Tag *tag = new Tag;
-
-			//Get the id
-			tag->id = "";
-			while (i < fileStr.length()
-				&& fileStr[i] != ' '
-				&& fileStr[i] != '\n'
-				&& fileStr[i] != '\r'
-				&& fileStr[i] != '/'
-				&& fileStr[i] != '>') {
-				tag->id += fileStr[i];
-				i++;
-			}
-
-			//Get attributes and keys
-			while (fileStr[i] != '>'
-				&& fileStr[i] != '/') {
-
-				//Found an attribute
-				if (fileStr[i] != ' '
-					&& fileStr[i] != '\n'
-					&& fileStr[i] != '\r') {
-					std::string attr = "";
-					std::string key = "";
-					while (fileStr[i] != '=') {
-						attr += fileStr[i];
-						i++;
-					}
-					i++;
-					while (fileStr[i] == ' '
-						|| fileStr[i] == '\n'
-						|| fileStr[i] == '\r') i++;
-					int numQuotes = 0;
-					while (numQuotes < 2) {
-						if (fileStr[i] == '"') {
-							i++;
-							numQuotes++;
-							continue;
-						}
-						key += fileStr[i];
-						i++;
-					}
-					tag->attributes.push_back(std::pair<std::string, std::string>(attr, key));
-				}
-				else {
-					i++;
-				}
-				//End found attribute
-
-			}
-
-			//At the end of a tag, check to see if has subtags
-			//Has no subtags
-			if (fileStr[i] == '/') {
-				i++;
-			}
-			//Has subtags
-			else {
-				i++;
-				generateTags(tag, fileStr, i);
-			}
-
-			parent->subTags.push_back(tag);
+			parent->subTags.push_back(readTag(arena, fileStr, i));
 		}
 		i++;
 	}
 }
 
-void XMLParser::destroyXMLObject(XMLObject *obj) {
-	if (obj == NULL) return;
-	for (unsigned int i = 0; i < obj->tags.size(); i++) {
-		recursiveDeleteTag(obj->tags[i]);
-		obj->tags[i] = NULL;
+Tag * XMLParser::readTag(Arena *arena, const XMLString &fileStr, unsigned int &i) {
+	Tag *tag = arena->create<Tag>(arena);
+
+	//Get the id
+	unsigned int idStart = i;
+	while (i < fileStr.length()
+		&& fileStr[i] != ' '
+		&& fileStr[i] != '\n'
+		&& fileStr[i] != '\r'
+		&& fileStr[i] != '/'
+		&& fileStr[i] != '>') {
+		i++;
 	}
-	obj->tags.clear();
-	delete obj;
-}
+	tag->id.assign(fileStr.data() + idStart, i - idStart);
+
+	//Get attributes and keys
+	while (fileStr[i] != '>'
+		&& fileStr[i] != '/') {
+
+		//Found an attribute
+		if (fileStr[i] != ' '
+			&& fileStr[i] != '\n'
+			&& fileStr[i] != '\r') {
+			unsigned int attrStart = i;
+			while (fileStr[i] != '=') i++;
+			unsigned int attrEnd = i;
+			while (fileStr[i] != '"') i++;
+			unsigned int keyStart = ++i;
+			while (fileStr[i] != '"') i++;
+			tag->attributes.push_back(XMLAttribute(XMLString(fileStr.data() + attrStart, attrEnd - attrStart, arena),
+				XMLString(fileStr.data() + keyStart, i - keyStart, arena)));
+			i++;
+		}
+		else {
+			i++;
+		}
+		//End found attribute
 
-void recursiveDeleteTag(Tag *tag) {
-	if (tag == NULL) return;
-	for (unsigned int i = 0; i < tag->subTags.size(); i++) {
-		recursiveDeleteTag(tag->subTags[i]);
-		tag->subTags[i] = NULL;
 	}
-	tag->subTags.clear();
-	delete tag;
+
+	//At the end of a tag, check to see if has subtags
+	//Has no subtags
+	if (fileStr[i] == '/') {
+		i++;
+	}
+	//Has subtags
+	else {
+		i++;
+		generateTags(arena, tag, fileStr, i);
+	}
+	return tag;
 }
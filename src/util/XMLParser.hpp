@@ -7,24 +7,33 @@
  * XML Parser will return NULL if it could not find the passed file
  * XML Parser has UNDEFINED BEHAVIOR if the xml file has incorrect format
  *	- only pass in valid XML files to the parser
- * 
- * NOTE: When deleting an XMLObject, make sure to use XMLParser::destroyXMLObject(XMLObject *obj);!
- *	- This will recursively delete all of the tags in XMLObject, if you don't you'll have a memory leak!
+ *
+ * NOTE: The whole XMLObject (the file, every tag and every string) lives in the arena passed to loadXML
+ *	- Don't delete any of it, reset or delete the arena once you are done with the XMLObject
  */
 
 #include <vector>
 #include <string>
+#include "Arena.hpp"
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > XMLString;
+typedef std::pair<XMLString, XMLString> XMLAttribute;
 
 typedef struct Tag {
-	std::vector<Tag *> subTags;
-	std::string id;
-	std::vector<std::pair<std::string, std::string>> attributes;
-	std::string data;
+	std::vector<Tag *, ArenaAllocator<Tag *> > subTags;
+	XMLString id;
+	std::vector<XMLAttribute, ArenaAllocator<XMLAttribute> > attributes;
+	XMLString data;
+
+	Tag(Arena *arena) : subTags(arena), id(arena), attributes(arena), data(arena) {}
 } Tag;
 
 typedef struct XMLObject {
-	std::vector<Tag *> tags;
-	std::string fileString;
+	std::vector<Tag *, ArenaAllocator<Tag *> > tags;
+	XMLString fileString;
+	Arena *arena;
+
+	XMLObject(Arena *a) : tags(a), fileString(a), arena(a) {}
 } XMLObject;
 
 class XMLParser {
@@ -32,11 +41,11 @@ private:
 	XMLParser() {}
 	~XMLParser() {}
 	static void generateTags(XMLObject *);
-	static void generateTags(Tag *, const std::string &, unsigned int &);
+	static void generateTags(Arena *, Tag *, const XMLString &, unsigned int &);
+	static Tag * readTag(Arena *, const XMLString &, unsigned int &);
 
 public:
-	static XMLObject * loadXML(const char *pathToXmlFile);
-	static void destroyXMLObject(XMLObject *xmlObj);
+	static XMLObject * loadXML(const char *pathToXmlFile, Arena *arena);
 };
 
-#endif 
+#endif
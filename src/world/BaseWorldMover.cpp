@@ -5,7 +5,7 @@
 #include "../sprite/Sprite.hpp"
 #include "../util/Utils.hpp"
 
-BaseWorldMover::BaseWorldMover(World *world, SpriteSheet *image, int movementUpdateTime, int movementSpeed) 
+BaseWorldMover::BaseWorldMover(World *world, const ResourceHandle<SpriteSheet> &image, int movementUpdateTime, int movementSpeed) 
 	: BaseWorldObject(world, image, movementUpdateTime),
 	displacement(0),
 	moveSpeed(movementSpeed),
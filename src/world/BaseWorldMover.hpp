@@ -2,12 +2,11 @@
 #define BASE_WORLD_MOVER
 
 #include "BaseWorldObject.hpp"
-
-typedef enum FacingDirection { NONE = 4, LEFT = 1, RIGHT = 2, UP = 3, DOWN = 0 } FacingDirection;
+#include "FacingDirection.hpp"
 
 class BaseWorldMover : public BaseWorldObject {
 public:
-	BaseWorldMover(World *world, SpriteSheet *image, int movementUpdateTime, int movementSpeed);
+	BaseWorldMover(World *world, const ResourceHandle<SpriteSheet> &image, int movementUpdateTime, int movementSpeed);
 	virtual ~BaseWorldMover() override;
 
 	void move(FacingDirection direction);
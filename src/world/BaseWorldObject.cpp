@@ -5,11 +5,12 @@
 #include "../sprite/Sprites.hpp"
 #include "../util/Util.hpp"
 
-BaseWorldObject::BaseWorldObject(World *world, SpriteSheet *image, int tickTime) :
+BaseWorldObject::BaseWorldObject(World *world, const ResourceHandle<SpriteSheet> &sheet, int tickTime) :
 	  BaseGameObject(tickTime),
       world(world),
+      image(sheet),
       layer(0), 
-      objectSprite(image->createSprite()) {
+      objectSprite(sheet.isReady() ? sheet->createSprite() : NULL) {
 	if (objectSprite == NULL) Util::fatalError("Failed to create a world object sprite");
 	SDL_Rect empty = Util::createRect(0, 0, 0, 0);
 	setSourceRect(empty); setDestinationRect(empty);
@@ -24,29 +25,65 @@ BaseWorldObject::~BaseWorldObject() {
     }
 }
 
-void BaseWorldObject::setRawX(int x) const { objectSprite->setDstX(x); }
-void BaseWorldObject::setRawY(int y) const { objectSprite->setDstY(y); }
-void BaseWorldObject::setWidth(int w) const { objectSprite->setDstW(w); }
-void BaseWorldObject::setHeight(int h) const { objectSprite->setDstH(h); }
+void BaseWorldObject::setRawX(int x) const { 
+	if (objectSprite->getDstX() == x) return;
+	objectSprite->setDstX(x); 
+	markDirty();
+}
+void BaseWorldObject::setRawY(int y) const { 
+	if (objectSprite->getDstY() == y) return;
+	objectSprite->setDstY(y); 
+	markDirty();
+}
+void BaseWorldObject::setWidth(int w) const { 
+	if (objectSprite->getDstW() == w) return;
+	objectSprite->setDstW(w); 
+	markDirty();
+}
+void BaseWorldObject::setHeight(int h) const { 
+	if (objectSprite->getDstH() == h) return;
+	objectSprite->setDstH(h); 
+	markDirty();
+}
 void BaseWorldObject::setTileX(int x) { 
 	tileX = x; 
 	posX = tileX * getWorld()->getMap()->getTileWidth(); 
+	previousPosX = posX;
+	markDirty();
 }
 void BaseWorldObject::setTileY(int y) { 
 	tileY = y; 
 	posY = tileY * getWorld()->getMap()->getTileHeight();
+	previousPosY = posY;
+	markDirty();
 }
 void BaseWorldObject::setPositionX(int x) { 
+	if (posX == x) return;
 	posX = x; 
+	markDirty();
 	if(posX == 0 || getWorld()->getMap()->getTileWidth() == 0) setTileX(0);
 	else tileX = posX / getWorld()->getMap()->getTileWidth();
 }
 void BaseWorldObject::setPositionY(int y) { 
+	if (posY == y) return;
 	posY = y;
+	markDirty();
 	if (posY == 0 || getWorld()->getMap()->getTileHeight() == 0) setTileY(0);
 	else tileY = posY / getWorld()->getMap()->getTileHeight();
 }
-void BaseWorldObject::setLayer(int newLayer) { layer = newLayer; }
+void BaseWorldObject::setLayer(int newLayer) { 
+	if (layer == newLayer) return;
+	layer = newLayer; 
+	markDirty();
+}
+void BaseWorldObject::markDirty() const { world->markDirty(); }
+
+void BaseWorldObject::onSavePreviousState() {
+	//Coming to rest needs one more frame at the final position
+	if (isInterpolating()) markDirty();
+	previousPosX = posX;
+	previousPosY = posY;
+}
 
 void BaseWorldObject::onDraw(Window *win) { objectSprite->draw(win); }
 
@@ -59,10 +96,31 @@ int BaseWorldObject::getTileY() const { return tileY; }
 int BaseWorldObject::getPositionX() const { return posX; }
 int BaseWorldObject::getPositionY() const { return posY; }
 int BaseWorldObject::getLayer() const { return layer; }
+int BaseWorldObject::getDrawPositionX(float stepProgress) const {
+	float progress = getObjectTickProgress(stepProgress);
+	return previousPosX + static_cast<int> ((posX - previousPosX) * progress + (posX >= previousPosX ? 0.5f : -0.5f));
+}
+int BaseWorldObject::getDrawPositionY(float stepProgress) const {
+	float progress = getObjectTickProgress(stepProgress);
+	return previousPosY + static_cast<int> ((posY - previousPosY) * progress + (posY >= previousPosY ? 0.5f : -0.5f));
+}
+bool BaseWorldObject::isInterpolating() const { return posX != previousPosX || posY != previousPosY; }
 World * BaseWorldObject::getWorld() const { return world; }
 
-void BaseWorldObject::setSourceRect(const SDL_Rect &srcRect) const { objectSprite->setSrcRect(srcRect); }
-void BaseWorldObject::setDestinationRect(const SDL_Rect &dstRect) const { objectSprite->setDstRect(dstRect); }
+void BaseWorldObject::setSourceRect(const SDL_Rect &srcRect) const { 
+	const SDL_Rect *current = objectSprite->getSrcRect();
+	if (current != NULL && current->x == srcRect.x && current->y == srcRect.y
+		&& current->w == srcRect.w && current->h == srcRect.h) return;
+	objectSprite->setSrcRect(srcRect); 
+	markDirty();
+}
+void BaseWorldObject::setDestinationRect(const SDL_Rect &dstRect) const { 
+	const SDL_Rect *current = objectSprite->getDstRect();
+	if (current != NULL && current->x == dstRect.x && current->y == dstRect.y
+		&& current->w == dstRect.w && current->h == dstRect.h) return;
+	objectSprite->setDstRect(dstRect); 
+	markDirty();
+}
 SDL_Rect BaseWorldObject::getSourceRect() const {
 	if (objectSprite->getSrcRect() != NULL) {
 		return *objectSprite->getSrcRect();
@@ -76,5 +134,7 @@ SDL_Rect BaseWorldObject::getDestinationRect() const {
 	return Util::createRect(0, 0, 0, 0);
 }
 
+SDL_Texture * BaseWorldObject::getTexture() const { return objectSprite->getTexture(); }
+
 void BaseWorldObject::getImageDimensions(int &w, int &h) const { Util::querySpriteSourceImage(objectSprite, w, h); }
 
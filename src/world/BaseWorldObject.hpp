@@ -2,6 +2,7 @@
 #define BASE_WORLD_OBJECT
 
 #include "../game/BaseGameObject.hpp"
+#include "../util/ResourceHandle.hpp"
 
 class Sprite;
 class SpriteSheet;
@@ -9,10 +10,12 @@ class Game;
 class Window;
 class World;
 struct SDL_Rect;
+struct SDL_Texture;
 
 class BaseWorldObject : public BaseGameObject {
 public:
-    BaseWorldObject(World *world, SpriteSheet *image, int tickTime);
+    //The object keeps the sprite sheet loaded, it has to be ready
+    BaseWorldObject(World *world, const ResourceHandle<SpriteSheet> &image, int tickTime);
     virtual ~BaseWorldObject();
 
     World * getWorld() const;
@@ -36,20 +39,34 @@ public:
     int getPositionX() const;
     int getPositionY() const;
     int getLayer() const;
+
+	//Position to draw at, between the previous and current object tick
+	int getDrawPositionX(float stepProgress) const;
+	int getDrawPositionY(float stepProgress) const;
+
+	//Still moving from the previous position towards the current one
+	bool isInterpolating() const;
     
 	void setSourceRect(const SDL_Rect &srcRect) const;
 	void setDestinationRect(const SDL_Rect &dstRect) const;
 	SDL_Rect getSourceRect() const;
 	SDL_Rect getDestinationRect() const;
+	SDL_Texture * getTexture() const;
 
 	void getImageDimensions(int &w, int &h) const;
 
 protected:
 	virtual void onDraw(Window *win);
 
+	//Tell the world that this object changed and the frame needs to be redrawn
+	void markDirty() const;
+
+	void onSavePreviousState() override;
+
 private:
     World *world;
-    int tileX, tileY, posX, posY, layer;
+    ResourceHandle<SpriteSheet> image;
+    int tileX, tileY, posX, posY, previousPosX, previousPosY, layer;
     Sprite *objectSprite;
 };
 
@@ -0,0 +1,175 @@
+#include "CrowdStress.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <SDL2/SDL.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include "World.hpp"
+#include "WorldEntities.hpp"
+#include "WorldScripts.hpp"
+#include "WorldNpc.hpp"
+#include "Script.hpp"
+#include "BaseWorldObject.hpp"
+#include "../game/Window.hpp"
+#include "../map/MapLoader.hpp"
+#include "../sprite/SpriteSheet.hpp"
+#include "../util/Constants.hpp"
+#include "../util/TimerWheel.hpp"
+#include "../util/Util.hpp"
+
+//Bytes of memory the process has resident, 0 where there's no /proc to ask
+static unsigned long long getResidentBytes() {
+#ifdef __linux__
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL) return 0;
+	unsigned long long pages = 0, resident = 0;
+	int read = fscanf(statm, "%llu %llu", &pages, &resident);
+	fclose(statm);
+	if (read != 2) return 0;
+	return resident * static_cast<unsigned long long> (sysconf(_SC_PAGESIZE));
+#else
+	return 0;
+#endif
+}
+
+CrowdStress::CrowdStress(unsigned int n, const std::string &map, unsigned int s, const std::string &path) : BaseGameObject(),
+	npcs(n), spawned(0), seconds(s > 0 ? s : Constants::STRESS_DEFAULT_SECONDS), mapName(map), reportPath(path), world(NULL),
+	startUs(0), startCosts(), random(2463534242u), reported(false) {}
+
+CrowdStress::~CrowdStress() {}
+
+void CrowdStress::start(Game *game, World *w) {
+	world = w;
+	if (!mapName.empty()) {
+		Map *map = MapLoader::getInstance()->getMap(AssetId(mapName));
+		if (map != NULL) world->changeMap(map);
+		else Util::log(SDL_LOG_PRIORITY_ERROR, "No map " + mapName + " to stress test, staying on " + world->getMap()->getMapName());
+	}
+	std::vector<int> freeTiles;
+	placePlayer(freeTiles);
+
+	//No map has room for the biggest crowds, so the map is laid out side by side as many times as it takes
+	Map *map = world->getMap();
+	if (freeTiles.size() < npcs && !freeTiles.empty()) {
+		//Room for one more than the crowd, wherever the player ends up standing
+		unsigned int copies = (npcs + freeTiles.size()) / freeTiles.size(), side = 1;
+		while (side * side < copies) side++;
+		std::string name = map->getMapName() + " x" + std::to_string(side * side);
+		Map *repeated = MapLoader::getInstance()->getMap(AssetId(name));
+		if (repeated == NULL) {
+			repeated = map->repeat(side, side, name.c_str());
+			repeated->generate(game);
+			if (!MapLoader::getInstance()->addMap(repeated)) Util::fatalError(("Failed to add the stress test map " + name).c_str());
+		}
+		world->changeMap(repeated);
+		map = repeated;
+		placePlayer(freeTiles);
+	}
+	WorldEntities *entities = world->getEntities();
+	spawned = npcs < freeTiles.size() ? npcs : static_cast<unsigned int> (freeTiles.size());
+	if (spawned < npcs) {
+		Util::log(SDL_LOG_PRIORITY_WARN, map->getMapName() + " only has room for " + std::to_string(spawned)
+			+ " NPCs, the stress test spawns that many instead of " + std::to_string(npcs));
+	}
+	//In a random order, so the crowd starts out spread over the map
+	for (unsigned int i = freeTiles.size(); i > 1; i--) std::swap(freeTiles[i - 1], freeTiles[nextRandom() % i]);
+
+	std::vector<ResourceHandle<SpriteSheet> > sheets;
+	char sheetName[16];
+	for (unsigned int i = 1; i <= Constants::STRESS_NPC_SHEETS; i++) {
+		snprintf(sheetName, sizeof(sheetName), "NPC %02u.png", i);
+		sheets.push_back(game->getSpriteSheet(AssetId(sheetName)));
+	}
+
+	//Take a step in a random direction, then another once it's over (or bumped into something)
+	Script walk;
+	walk.call([this](WorldNpc &npc) { npc.move(randomDirection()); }).waitForMoveEnd().loop();
+	ScriptId walkId = world->getScripts()->define(walk);
+	for (unsigned int i = 0; i < spawned; i++) {
+		int tile = freeTiles[i];
+		Entity npc = entities->spawnCharacter(sheets[i % sheets.size()], tile % map->getWidth(), tile / map->getWidth(), DOWN);
+		world->getScripts()->run(npc, walkId);
+	}
+	Util::log(SDL_LOG_PRIORITY_INFO, "Stress testing " + std::to_string(spawned) + " NPCs on " + map->getMapName()
+		+ " (" + std::to_string(freeTiles.size()) + " free tiles) for " + std::to_string(seconds) + "s");
+
+	startUs = game->getTimers()->getTimeMicroseconds();
+	startCosts = game->getCosts();
+	wallStart = std::chrono::steady_clock::now();
+	game->schedule(this);
+}
+
+void CrowdStress::onGameTick(Game *game) {
+	if (reported || game->getTimers()->getTimeMicroseconds() - startUs < seconds * 1000000ULL) return;
+	reported = true;
+	report(game);
+	game->quit();
+}
+
+void CrowdStress::placePlayer(std::vector<int> &freeTiles) {
+	Map *map = world->getMap();
+	world->getPlayer()->setTileX(map->getWidth() / 2);
+	world->getPlayer()->setTileY(map->getHeight() / 2);
+	WorldEntities *entities = world->getEntities();
+	entities->holdPlayerTiles(map->getWidth() / 2, map->getHeight() / 2, -1, -1);
+
+	freeTiles.clear();
+	for (int y = 0; y < map->getHeight(); y++) {
+		for (int x = 0; x < map->getWidth(); x++) {
+			if (entities->isWalkable(x, y)) freeTiles.push_back(y * map->getWidth() + x);
+		}
+	}
+}
+
+//Xorshift, the scripts all share it and run on the simulation thread one at a time
+unsigned int CrowdStress::nextRandom() {
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+	return random;
+}
+
+FacingDirection CrowdStress::randomDirection() {
+	static const FacingDirection DIRECTIONS[4] = { UP, DOWN, LEFT, RIGHT };
+	return DIRECTIONS[nextRandom() % 4];
+}
+
+void CrowdStress::report(Game *game) {
+	GameCosts costs = game->getCosts();
+	unsigned long long steps = costs.steps - startCosts.steps, frames = costs.frames - startCosts.frames;
+	double tickUs = steps > 0 ? (costs.stepNanoseconds - startCosts.stepNanoseconds) / 1000.0 / steps : 0.0;
+	double renderUs = frames > 0 ? (costs.renderNanoseconds - startCosts.renderNanoseconds) / 1000.0 / frames : 0.0;
+	//Headless runs go faster than real time, frames per second are per second of the run, not of game time
+	std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+	double fps = wall.count() > 0 ? frames / wall.count() : 0.0;
+	double residentMb = getResidentBytes() / (1024.0 * 1024.0);
+	double textureMb = Window::getTextureBytes() / (1024.0 * 1024.0);
+	const char *mode = game->isHeadless() ? "headless" : "windowed";
+	std::string map = world->getMap()->getMapName();
+
+	char line[256];
+	snprintf(line, sizeof(line), "%s,%s,%u,%u,%u,%.2f,%llu,%.3f,%llu,%.3f,%.1f,%.1f,%.1f\n",
+		mode, map.c_str(), npcs, spawned, seconds, wall.count(), steps, tickUs, frames, renderUs, fps, residentMb, textureMb);
+	Util::log(SDL_LOG_PRIORITY_INFO, "Stress test (" + std::string(mode) + ", " + std::to_string(spawned) + " NPCs): "
+		+ std::to_string(steps) + " steps at " + std::to_string(tickUs) + " us, "
+		+ std::to_string(frames) + " frames at " + std::to_string(renderUs) + " us, "
+		+ std::to_string(residentMb) + " MB resident, " + std::to_string(textureMb) + " MB of textures");
+	if (reportPath.empty()) return;
+
+	//One line per run, so runs with different crowd sizes add up to one table
+	SDL_RWops *file = SDL_RWFromFile(reportPath.c_str(), "ab");
+	if (file == NULL) {
+		Util::log(SDL_LOG_PRIORITY_ERROR, "Failed to open the stress test report " + reportPath + ": " + SDL_GetError());
+		return;
+	}
+	if (SDL_RWsize(file) == 0) {
+		static const char HEADER[] = "mode,map,npcs,spawned,seconds,wall_seconds,steps,tick_us,frames,render_us,fps,resident_mb,texture_mb\n";
+		SDL_RWwrite(file, HEADER, 1, sizeof(HEADER) - 1);
+	}
+	SDL_RWwrite(file, line, 1, strlen(line));
+	SDL_RWclose(file);
+}
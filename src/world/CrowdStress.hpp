@@ -0,0 +1,56 @@
+#ifndef CROWD_STRESS_HPP
+#define CROWD_STRESS_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../game/BaseGameObject.hpp"
+#include "../game/Game.hpp"
+#include "FacingDirection.hpp"
+
+class World;
+
+/**
+ * Fills a map with NPCs that walk around at random, for finding out how far the world scales
+ * After a while of game time it reports what a step and a frame cost on average and how much memory the game holds,
+ * then quits the game, one run per crowd size:
+ *
+ *     game.out --headless 100000000 --stress 1000 --stress-map pallet_town.tmx --stress-report stress.csv
+ *
+ * The NPCs are entities running a shared script, one to a free tile: for a crowd bigger than the map has room for
+ * the map is repeated side by side (a square of copies, "pallet_town.tmx x16") until it fits
+ * A map with no free tiles at all can't be repeated, the crowd is cut down to fit (with a warning),
+ * so the report has both the crowd asked for and the one spawned
+ */
+class CrowdStress : public BaseGameObject {
+public:
+	CrowdStress(unsigned int npcs, const std::string &mapName, unsigned int seconds, const std::string &reportPath);
+	~CrowdStress() override;
+
+	//Once the world has started, change to the map, spawn the crowd and start the clock
+	void start(Game *game, World *world);
+
+protected:
+	void onGameTick(Game *game) override;
+
+private:
+	unsigned int npcs, spawned, seconds;
+	std::string mapName, reportPath;
+	World *world;
+	unsigned long long startUs;
+	GameCosts startCosts;
+	std::chrono::steady_clock::time_point wallStart;
+	unsigned int random;
+	bool reported;
+
+	//Stand the player in the middle of the world's map and list the tiles the crowd can start on
+	void placePlayer(std::vector<int> &freeTiles);
+	FacingDirection randomDirection();
+	unsigned int nextRandom();
+	void report(Game *game);
+
+	CrowdStress(const CrowdStress &);
+	CrowdStress & operator=(const CrowdStress &);
+};
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef FACING_DIRECTION_HPP
+#define FACING_DIRECTION_HPP
+
+//Also the row of the direction in character sprite sheets
+typedef enum FacingDirection { NONE = 4, LEFT = 1, RIGHT = 2, UP = 3, DOWN = 0 } FacingDirection;
+
+#endif
@@ -0,0 +1,53 @@
+#include "Script.hpp"
+
+Script::Script() : looping(false) {}
+
+Script::~Script() {}
+
+Script & Script::walkTo(int tileX, int tileY) {
+	ScriptStep &step = add(SCRIPT_WALK_TO);
+	step.tileX = tileX;
+	step.tileY = tileY;
+	return *this;
+}
+
+Script & Script::wait(unsigned int ms) {
+	add(SCRIPT_WAIT).ms = ms;
+	return *this;
+}
+
+Script & Script::showText(const std::string &text, unsigned int ms) {
+	ScriptStep &step = add(SCRIPT_SHOW_TEXT);
+	step.text = text;
+	step.ms = ms;
+	return *this;
+}
+
+Script & Script::waitForMoveEnd() {
+	add(SCRIPT_WAIT_FOR_MOVE_END);
+	return *this;
+}
+
+Script & Script::call(const ScriptFunction &function) {
+	add(SCRIPT_CALL).function = function;
+	return *this;
+}
+
+Script & Script::loop() {
+	looping = true;
+	return *this;
+}
+
+const std::vector<ScriptStep> & Script::getSteps() const { return steps; }
+
+bool Script::isLooping() const { return looping; }
+
+ScriptStep & Script::add(ScriptStepType type) {
+	ScriptStep step;
+	step.type = type;
+	step.tileX = 0;
+	step.tileY = 0;
+	step.ms = 0;
+	steps.push_back(step);
+	return steps.back();
+}
@@ -0,0 +1,70 @@
+#ifndef SCRIPT_HPP
+#define SCRIPT_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+
+class WorldNpc;
+
+enum ScriptStepType {
+	SCRIPT_WALK_TO,
+	SCRIPT_WAIT,
+	SCRIPT_SHOW_TEXT,
+	SCRIPT_WAIT_FOR_MOVE_END,
+	SCRIPT_CALL
+};
+
+typedef std::function<void(WorldNpc &npc)> ScriptFunction;
+
+typedef struct ScriptStep {
+	ScriptStepType type;
+	int tileX, tileY;
+	unsigned int ms;
+	std::string text;
+	ScriptFunction function;
+} ScriptStep;
+
+/**
+ * What an NPC (or a cutscene) does, written as a list of steps that run one after another:
+ *
+ *     Script patrol;
+ *     patrol.walkTo(4, 10).wait(2000).walkTo(12, 10).wait(2000).loop();
+ *
+ * A step that waits for something puts the script to sleep until that something happens,
+ * sleeping scripts are never looked at, see WorldScripts
+ */
+class Script {
+public:
+	Script();
+	~Script();
+
+	//Walk tile by tile until standing on the tile, going around whatever is in the way when it can
+	Script & walkTo(int tileX, int tileY);
+
+	//Do nothing for a while
+	Script & wait(unsigned int ms);
+
+	//Show text in the world's text box, the script carries on once the box goes away
+	Script & showText(const std::string &text, unsigned int ms);
+
+	//Wait until the NPC gets to its next tile (ie: after starting a move from call)
+	Script & waitForMoveEnd();
+
+	//Run some code, it carries straight on to the next step
+	Script & call(const ScriptFunction &function);
+
+	//Start over from the first step after the last one
+	Script & loop();
+
+	const std::vector<ScriptStep> & getSteps() const;
+	bool isLooping() const;
+
+private:
+	std::vector<ScriptStep> steps;
+	bool looping;
+
+	ScriptStep & add(ScriptStepType type);
+};
+
+#endif
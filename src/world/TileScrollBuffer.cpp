@@ -0,0 +1,159 @@
+#include "TileScrollBuffer.hpp"
+
+#include <SDL2/SDL_render.h>
+#include "../game/Window.hpp"
+#include "../map/Maps.hpp"
+#include "../util/Util.hpp"
+
+//Modulo and division that round towards negative infinity, the world goes left and up of the map too
+static int wrap(int value, int size) { int m = value % size; return m < 0 ? m + size : m; }
+static int floorDivide(int value, int size) { return (value - wrap(value, size)) / size; }
+
+TileScrollBuffer::TileScrollBuffer(int viewColumns, int viewRows, bool isTransparent)
+	: columns(viewColumns + 1),
+	rows(viewRows + 1),
+	tileWidth(0),
+	tileHeight(0),
+	originTileX(0),
+	originTileY(0),
+	firstLayer(0),
+	lastLayer(0),
+	transparent(isTransparent),
+	valid(false),
+	centerMap(NULL),
+	texture(NULL) {}
+
+TileScrollBuffer::~TileScrollBuffer() {
+	if (texture != NULL) {
+		Window::destroyTexture(texture);
+		texture = NULL;
+	}
+	centerMap = NULL;
+}
+
+void TileScrollBuffer::setLayers(unsigned int first, unsigned int last) {
+	if (first == firstLayer && last == lastLayer) return;
+	firstLayer = first;
+	lastLayer = last;
+	invalidate();
+}
+
+void TileScrollBuffer::invalidate() { valid = false; }
+
+void TileScrollBuffer::scrollTo(Window *win, Map *map, const SDL_Rect &camera) {
+	if (map != centerMap) {
+		centerMap = map;
+		invalidate();
+	}
+
+	//(Re)create the texture when the tile size changes
+	if (texture == NULL || tileWidth != map->getTileWidth() || tileHeight != map->getTileHeight()) {
+		if (texture != NULL) Window::destroyTexture(texture);
+		tileWidth = map->getTileWidth();
+		tileHeight = map->getTileHeight();
+		texture = transparent ? win->createTransparentTexture(columns * tileWidth, rows * tileHeight)
+			: win->createTexture(columns * tileWidth, rows * tileHeight);
+		invalidate();
+	}
+
+	int newTileX = floorDivide(camera.x, tileWidth);
+	int newTileY = floorDivide(camera.y, tileHeight);
+	if (valid && newTileX == originTileX && newTileY == originTileY) return;
+
+	win->setRenderTarget(texture);
+	int lastTileX = newTileX + columns - 1;
+	int lastTileY = newTileY + rows - 1;
+
+	//Nothing usable in the buffer, draw every slot
+	if (!valid 
+		|| newTileX - originTileX >= columns || originTileX - newTileX >= columns
+		|| newTileY - originTileY >= rows || originTileY - newTileY >= rows) {
+		drawTiles(win, newTileX, lastTileX, newTileY, lastTileY);
+	}
+
+	//Only draw the columns and rows that scrolled into view
+	else {
+		if (newTileX > originTileX) drawTiles(win, originTileX + columns, lastTileX, newTileY, lastTileY);
+		else if (newTileX < originTileX) drawTiles(win, newTileX, originTileX - 1, newTileY, lastTileY);
+		if (newTileY > originTileY) drawTiles(win, newTileX, lastTileX, originTileY + rows, lastTileY);
+		else if (newTileY < originTileY) drawTiles(win, newTileX, lastTileX, newTileY, originTileY - 1);
+	}
+
+	win->resetRenderTarget();
+	originTileX = newTileX;
+	originTileY = newTileY;
+	valid = true;
+}
+
+void TileScrollBuffer::draw(Window *win, const SDL_Rect &camera) const {
+	if (texture == NULL || !valid) return;
+	int bufferWidth = columns * tileWidth;
+	int bufferHeight = rows * tileHeight;
+	int startX = wrap(camera.x, bufferWidth);
+	int startY = wrap(camera.y, bufferHeight);
+
+	//The view can wrap past the right and bottom edges of the buffer, split it into up to four pieces
+	int firstWidth = camera.w < bufferWidth - startX ? camera.w : bufferWidth - startX;
+	int firstHeight = camera.h < bufferHeight - startY ? camera.h : bufferHeight - startY;
+	int widths[2] = { firstWidth, camera.w - firstWidth };
+	int heights[2] = { firstHeight, camera.h - firstHeight };
+	for (int y = 0; y < 2; y++) {
+		if (heights[y] <= 0) continue;
+		for (int x = 0; x < 2; x++) {
+			if (widths[x] <= 0) continue;
+			SDL_Rect src = Util::createRect(x == 0 ? startX : 0, y == 0 ? startY : 0, widths[x], heights[y]);
+			SDL_Rect dst = Util::createRect(camera.x + (x == 0 ? 0 : firstWidth),
+				camera.y + (y == 0 ? 0 : firstHeight),
+				widths[x],
+				heights[y]);
+			win->drawTexture(texture, &src, &dst);
+		}
+	}
+}
+
+void TileScrollBuffer::drawTiles(Window *win, int fromTileX, int toTileX, int fromTileY, int toTileY) {
+	for (int y = fromTileY; y <= toTileY; y++) {
+		for (int x = fromTileX; x <= toTileX; x++) {
+			drawTile(win, x, y);
+		}
+	}
+}
+
+/**
+ * Draw a single world tile into its slot
+ * Tiles off the edges of the center map come from the bordering maps,
+ * which line up against the matching edge of the center map
+ */
+void TileScrollBuffer::drawTile(Window *win, int tileX, int tileY) {
+	SDL_Rect slot = Util::createRect(wrap(tileX, columns) * tileWidth, wrap(tileY, rows) * tileHeight, tileWidth, tileHeight);
+	win->eraseRect(slot, transparent);
+
+	Map *source = centerMap;
+	if (tileY < 0) {
+		source = centerMap->getBorderingMap(MapDirection::MAP_NORTH);
+		if (source != NULL) tileY += source->getHeight();
+	}
+	else if (tileY >= centerMap->getHeight()) {
+		source = centerMap->getBorderingMap(MapDirection::MAP_SOUTH);
+		tileY -= centerMap->getHeight();
+	}
+	else if (tileX < 0) {
+		source = centerMap->getBorderingMap(MapDirection::MAP_WEST);
+		if (source != NULL) tileX += source->getWidth();
+	}
+	else if (tileX >= centerMap->getWidth()) {
+		source = centerMap->getBorderingMap(MapDirection::MAP_EAST);
+		tileX -= centerMap->getWidth();
+	}
+	if (source == NULL || source->getTilesetTexture() == NULL) return;
+
+	for (unsigned int layer = firstLayer; layer <= lastLayer && layer < source->getNumberOfLayers(); layer++) {
+		Tile *tile = source->getTile(layer, tileX, tileY);
+		if (tile == NULL) continue;
+		SDL_Rect src = Util::createRect(tile->getRow() * tileWidth,
+			tile->getColumn() * tileHeight,
+			tileWidth,
+			tileHeight);
+		win->drawTexture(source->getTilesetTexture(), &src, &slot);
+	}
+}
@@ -0,0 +1,45 @@
+#ifndef TILE_SCROLL_BUFFER_HPP
+#define TILE_SCROLL_BUFFER_HPP
+
+class Window;
+class Map;
+struct SDL_Texture;
+struct SDL_Rect;
+
+/**
+ * Ring buffer texture holding the map tiles around the camera
+ * The buffer is one tile wider and taller than the view and wraps around in both directions,
+ * world tile (x, y) always lives in slot (x mod columns, y mod rows)
+ * When the camera crosses a tile boundary only the newly exposed rows and columns are drawn,
+ * and the view is drawn to the window with at most four blits
+ */
+class TileScrollBuffer {
+public:
+	TileScrollBuffer(int viewColumns, int viewRows, bool transparent);
+	~TileScrollBuffer();
+
+	//Only buffer the map layers from first up to and including last
+	void setLayers(unsigned int first, unsigned int last);
+
+	//Bring the buffer up to date for a camera (in world pixels) over the given map
+	//Must be called while no camera is set on the window
+	void scrollTo(Window *win, Map *map, const SDL_Rect &camera);
+
+	//Draw what the camera sees, the same camera must be set on the window
+	void draw(Window *win, const SDL_Rect &camera) const;
+
+	//Throw away the buffer contents, everything is redrawn on the next scroll
+	void invalidate();
+
+private:
+	int columns, rows, tileWidth, tileHeight, originTileX, originTileY;
+	unsigned int firstLayer, lastLayer;
+	bool transparent, valid;
+	Map *centerMap;
+	SDL_Texture *texture;
+
+	void drawTiles(Window *win, int fromTileX, int toTileX, int fromTileY, int toTileY);
+	void drawTile(Window *win, int tileX, int tileY);
+};
+
+#endif
@@ -1,13 +1,18 @@
 #include "World.hpp"
 
 #include <algorithm>
-#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_rect.h>
 #include "../game/Game.hpp"
 #include "../map/MapLoader.hpp"
 #include "../sprite/Sprites.hpp"
 #include "../util/Utils.hpp"
+#include "../util/AllocationTracker.hpp"
+#include "../util/Trace.hpp"
 #include "WorldCharacter.hpp"
 #include "WorldTextBox.hpp"
+#include "TileScrollBuffer.hpp"
+#include "WorldEntities.hpp"
+#include "WorldScripts.hpp"
 
 /**
 * Move listener for the player
@@ -24,182 +29,253 @@ public:
 	void onMoveEnd(FacingDirection direction, int tileX, int tileY) override;
 };
 
-World::World() : map(NULL), mapTexture(NULL), player(NULL), routeTextBox(NULL) {}
+World::World() : 
+	map(NULL), 
+	player(NULL), 
+	routeTextBox(NULL), 
+	entities(new WorldEntities(this)),
+	scripts(NULL),
+	dirty(true),
+	wasMoving(false),
+	published(false),
+	version(0),
+	lastPlayerX(0),
+	lastPlayerY(0),
+	groundLayers(new TileScrollBuffer(Constants::WORLD_DRAW_WIDTH, Constants::WORLD_DRAW_HEIGHT, false)),
+	overheadLayers(new TileScrollBuffer(Constants::WORLD_DRAW_WIDTH, Constants::WORLD_DRAW_HEIGHT, true)),
+	routeText(NULL),
+	routeTextFont(NULL),
+	drawnVersion(0),
+	redraw(true) {
+	scripts = new WorldScripts(this, entities);
+}
 
 World::~World() { 
 	if(player != NULL) {
         delete player;
         player = NULL;
     }
-	if (mapTexture != NULL) {
-		SDL_DestroyTexture(mapTexture);
-		mapTexture = NULL;
-	}
 	if (routeTextBox != NULL) {
 		delete routeTextBox;
 		routeTextBox = NULL;
 	}
+	delete groundLayers;
+	groundLayers = NULL;
+	delete overheadLayers;
+	overheadLayers = NULL;
+	delete scripts;
+	scripts = NULL;
+	delete entities;
+	entities = NULL;
+	if (routeText != NULL) {
+		delete routeText;
+		routeText = NULL;
+	}
+	routeTextFont = NULL;
 	map = NULL;
 }
 
 void World::start(Game *game) {
+	scripts->start(game->getTimers());
 	changeMap(Constants::MAP_ROUTE_1);
 
-	routeTextBox = new WorldTextBox(this, game->getSpriteSheet("choice 1.png"), game->getFont(Constants::FONT_JOYSTIX), false);
-	player = new WorldCharacter(this, game->getSpriteSheet("NPC 01.png"), Constants::CHARACTER_WALK_TIMER, Constants::CHARACTER_WALK_SPEED);
+	routeTextBox = new WorldTextBox(this, game->getSpriteSheet("choice 1.png"_asset), game->getFont(Constants::FONT_JOYSTIX), false);
+	player = new WorldCharacter(this, game->getSpriteSheet("NPC 01.png"_asset), Constants::CHARACTER_WALK_TIMER, Constants::CHARACTER_WALK_SPEED);
 	static_cast<WorldCharacter *>(player)->setOnMoveListener(new PlayerMoveListener(this));
 	player->setTileX(9); player->setTileY(32);
 	game->schedule(player);
 	game->schedule(routeTextBox);
+	game->schedule(entities);
+
+	//Something to draw before the first step
+	publishSnapshot();
 }
 
 void World::stop(Game *game) {
+	scripts->clear();
 	game->unschedule(player);
 	game->unschedule(routeTextBox);
+	game->unschedule(entities);
 }
 
-void World::render(Window *win) {
-    drawMap(win);
-}
+void World::pause(Game *game) {
+	scripts->pauseAll();
+	game->unschedule(player);
+	game->unschedule(routeTextBox);
+	game->unschedule(entities);
 
-/**
- * Draw the current map to the window
-*/
-void World::drawMap(Window *win) {
+	//Once more with nothing moving, otherwise the last step would be drawn in between forever
+	publishSnapshot();
+}
 
-	int drawWidth = Constants::WORLD_DRAW_WIDTH * map->getTileWidth();
-	int drawHeight = Constants::WORLD_DRAW_HEIGHT * map->getTileHeight();
+void World::resume(Game *game) {
+	game->schedule(player);
+	game->schedule(routeTextBox);
+	game->schedule(entities);
+	scripts->resumeAll();
+}
 
-	if(mapTexture == NULL) mapTexture = win->createTexture(drawWidth * 2, drawHeight * 2);
+void World::handleEvent(const GameEvent &event) {
+	//The scroll buffers have the old tile baked in
+	if (event.type == GAME_EVENT_TILE_CHANGED) {
+		groundLayers->invalidate();
+		overheadLayers->invalidate();
+		redraw = true;
+	}
+}
 
-	win->setRenderTarget(mapTexture);
-    win->clearRenderTarget();
+void World::publishSnapshot() {
+	WorldSnapshot &snapshot = snapshots.getBack();
+	snapshot.map = map;
 
-	SDL_Rect mapSrc = Util::createRect(player->getPositionX(), player->getPositionY(),  drawWidth, drawHeight);
-	SDL_Rect mapDst = Util::createRect(drawWidth / 2, drawHeight / 2, drawWidth, drawHeight);
+	//The player as of this step, right where its object tick has got to
+	int playerX = player->getDrawPositionX(0.0f);
+	int playerY = player->getDrawPositionY(0.0f);
+	snapshot.playerPreviousX = published ? lastPlayerX : playerX;
+	snapshot.playerPreviousY = published ? lastPlayerY : playerY;
+	snapshot.playerX = lastPlayerX = playerX;
+	snapshot.playerY = lastPlayerY = playerY;
+	snapshot.playerLayer = player->getLayer();
+	snapshot.playerTexture = player->getTexture();
+	snapshot.playerSrc = player->getSourceRect();
+	snapshot.playerWidth = player->getWidth();
+	snapshot.playerHeight = player->getHeight();
 
-	//Deal with x < 0
-	int targetX = mapSrc.x - drawWidth / 2 + map->getTileWidth() / 2;
-	if (targetX < 0) {
-		mapSrc.x = 0;
-		mapDst.x -= player->getPositionX() - drawWidth / 2 + map->getTileWidth() / 2;
-		drawBorderingMap(win, MapDirection::MAP_WEST, mapSrc, mapDst);
+	WorldTextBox *textBox = static_cast<WorldTextBox *> (routeTextBox);
+	snapshot.textBoxShown = textBox != NULL && textBox->isShown() && !textBox->isDialogue();
+	if (snapshot.textBoxShown) {
+		snapshot.textBoxTexture = textBox->getTexture();
+		snapshot.textBoxSrc = textBox->getSourceRect();
+		snapshot.textBoxDst = textBox->getDestinationRect();
+		snapshot.textBoxText = textBox->getText();
+		snapshot.textBoxFont = textBox->getFont();
 	}
 
-	//Deal with x > map width
-	else if (targetX > (map->getWidth() * map->getTileWidth()) - drawWidth) {
-		mapSrc.x = map->getWidth() * map->getTileWidth() - drawWidth;
-		mapDst.x += (map->getWidth() * map->getTileWidth())
-			- player->getPositionX() - drawWidth / 2 - map->getTileWidth() / 2;
-		drawBorderingMap(win, MapDirection::MAP_EAST, mapSrc, mapDst);
-	}
+	bool entitiesMoved = entities->capture(snapshot.entities, snapshot.entitiesVersion);
+	snapshot.moving = entitiesMoved || snapshot.playerPreviousX != playerX || snapshot.playerPreviousY != playerY;
 
-	//No issues on x axis
-	else {
-		mapSrc.x = targetX;
-	}
+	//Coming to rest needs one more frame at the final positions
+	if (dirty || snapshot.moving || wasMoving) version++;
+	snapshot.version = version;
+	wasMoving = snapshot.moving;
+	dirty = false;
+	published = true;
+	snapshots.publish();
+}
 
-	//Deal with y < 0
-	int targetY = mapSrc.y - drawHeight / 2 + map->getTileHeight() / 2;
-	if (targetY < 0) {
-		mapSrc.y = 0;
-		mapDst.y -= player->getPositionY() - drawHeight / 2 + map->getTileHeight() / 2;
-		drawBorderingMap(win, MapDirection::MAP_NORTH, mapSrc, mapDst);
-	}
+void World::acquireSnapshot() { snapshots.acquire(); }
 
-	//Deal with y > map height
-	else if (targetY > (map->getHeight() * map->getTileHeight()) - drawHeight) {
-		mapSrc.y = (map->getHeight() * map->getTileHeight()) - drawHeight;
-		mapDst.y += (map->getHeight() * map->getTileHeight()) 
-			- player->getPositionY() - drawHeight / 2 - map->getTileHeight() / 2;
-		drawBorderingMap(win, MapDirection::MAP_SOUTH, mapSrc, mapDst);
-	}
+void World::render(Window *win) {
+	const WorldSnapshot &snapshot = snapshots.getFront();
+	if (snapshot.map == NULL) return;
+	drawMap(win, snapshot);
+	drawTextBox(win, snapshot);
+}
 
-	//No issues on y axis
-	else {
-		mapSrc.y = targetY;
-	}
+static int interpolate(int previous, int current, float progress) {
+	return previous + static_cast<int> ((current - previous) * progress + (current >= previous ? 0.5f : -0.5f));
+}
 
-    //Draw the map
-	for (unsigned int i = 0; i < map->getNumberOfLayers(); i++) {
-		win->drawTexture(map->getLayer(i), &mapSrc, &mapDst);
-		if (i == static_cast<unsigned int> (player->getLayer() + 1)) {
-			player->setRawX(drawWidth - player->getWidth() / 2);
-			player->setRawY(drawHeight - player->getHeight() / 2 + Constants::CHARACTER_TILE_OFFSET_Y);
-			player->draw(win);
-		}
-	}
+/**
+ * Draw the current map to the window
+ * Everything is drawn straight to the window through the camera,
+ * which keeps the player's tile centered in the view
+*/
+void World::drawMap(Window *win, const WorldSnapshot &snapshot) {
+	TRACE_SCOPE("World::drawMap");
+	AllocationScope allocations(ALLOCATION_MAP);
+	Map *drawnMap = snapshot.map;
+	int drawWidth = Constants::WORLD_DRAW_WIDTH * drawnMap->getTileWidth();
+	int drawHeight = Constants::WORLD_DRAW_HEIGHT * drawnMap->getTileHeight();
 
-	mapSrc = Util::createRect(drawWidth / 2, drawHeight / 2, drawWidth, drawHeight);
+	//Follow where the player is drawn between the last two simulation steps, not just where it last stepped to
+	float stepProgress = win->getInterpolation();
+	int playerX = interpolate(snapshot.playerPreviousX, snapshot.playerX, stepProgress);
+	int playerY = interpolate(snapshot.playerPreviousY, snapshot.playerY, stepProgress);
+	SDL_Rect camera = Util::createRect(playerX - drawWidth / 2 + drawnMap->getTileWidth() / 2,
+		playerY - drawHeight / 2 + drawnMap->getTileHeight() / 2,
+		drawWidth,
+		drawHeight);
 
-	win->resetRenderTarget();
-	win->drawTexture(mapTexture, &mapSrc, NULL);
+	//The player is drawn over the layer above its own, everything higher goes over the player
+	unsigned int playerLayer = static_cast<unsigned int> (snapshot.playerLayer + 1);
+	groundLayers->setLayers(0, playerLayer);
+	overheadLayers->setLayers(playerLayer + 1, drawnMap->getNumberOfLayers());
+	groundLayers->scrollTo(win, drawnMap, camera);
+	overheadLayers->scrollTo(win, drawnMap, camera);
 
-	if (routeTextBox != NULL) routeTextBox->draw(win);
+	win->setCamera(camera);
+	groundLayers->draw(win, camera);
+	drawList.build(snapshot.entities, camera, stepProgress);
+	drawList.draw(win);
+	SDL_Rect playerSrc = snapshot.playerSrc;
+	SDL_Rect playerDst = Util::createRect(playerX + drawnMap->getTileWidth() / 2 - snapshot.playerWidth / 2,
+		playerY + drawnMap->getTileHeight() / 2 - snapshot.playerHeight / 2 + Constants::CHARACTER_TILE_OFFSET_Y,
+		snapshot.playerWidth,
+		snapshot.playerHeight);
+	win->drawTexture(snapshot.playerTexture, &playerSrc, &playerDst);
+	if (playerLayer + 1 < drawnMap->getNumberOfLayers()) overheadLayers->draw(win, camera);
+	win->resetCamera();
 }
 
-/**
- * Draw any bordering map
- */
-void World::drawBorderingMap(Window *win, MapDirection direction, SDL_Rect, SDL_Rect mapDst) {
-	Map *borderMap = map->getBorderingMap(direction);
-	if (borderMap == NULL) return;
-	int drawWidth = Constants::WORLD_DRAW_WIDTH * borderMap->getTileWidth();
-	int drawHeight = Constants::WORLD_DRAW_HEIGHT * borderMap->getTileHeight();
-	SDL_Rect src = Util::createRect(player->getPositionX(), player->getPositionY(), drawWidth, drawHeight);
-	src.x = src.x - drawWidth / 2 + borderMap->getTileWidth() / 2;
-	SDL_Rect dst = Util::createRect(drawWidth / 2, drawHeight / 2, drawWidth, drawHeight);
-	switch (direction) {
-	case MapDirection::MAP_NORTH: {
-		int h = mapDst.y - dst.y;
-		src.y = borderMap->getHeight() * borderMap->getTileHeight() - h;
-		src.h = h;
-		dst.h = h;
-		break;
-	}
-	case MapDirection::MAP_EAST: {
-		break;
-	}
-	case MapDirection::MAP_SOUTH: {
-		src.y = 0;
-		src.h = dst.y - mapDst.y;
-		dst.h = dst.y - mapDst.y;
-		dst.y = mapDst.y + mapDst.h;
-		break;
-	}
-	case MapDirection::MAP_WEST: {
-		break;
-	}
-	default:
-		return;
-	}
+void World::drawTextBox(Window *win, const WorldSnapshot &snapshot) {
+	if (!snapshot.textBoxShown) return;
+	AllocationScope allocations(ALLOCATION_TEXT);
+	SDL_Rect boxSrc = snapshot.textBoxSrc;
+	SDL_Rect boxDst = snapshot.textBoxDst;
+	win->drawTexture(snapshot.textBoxTexture, &boxSrc, &boxDst);
 
-	//Draw the map
-	for (unsigned int i = 0; i < borderMap->getNumberOfLayers(); i++) {
-		win->drawTexture(borderMap->getLayer(i), &src, &dst);
+	//The text texture is only made again when the text or the font changes
+	if (routeText == NULL || routeTextFont != snapshot.textBoxFont) {
+		if (routeText != NULL) delete routeText;
+		routeText = snapshot.textBoxFont->createFontSprite(win, snapshot.textBoxText);
+		routeTextFont = snapshot.textBoxFont;
+	}
+	else if (routeText->getText() != snapshot.textBoxText) {
+		routeText->setText(win, snapshot.textBoxText);
 	}
+	routeText->getSprite()->setDstRect(Util::createRect(boxDst.x + boxDst.w / 4,
+		boxDst.y + boxDst.h / 4,
+		boxDst.w / 2,
+		boxDst.h / 2));
+	routeText->draw(win);
 }
 
 /**
  *Change the current map
  */
-void World::changeMap(const char * const mapFile) {
-	changeMap(MapLoader::getInstance()->getMap(mapFile));
+void World::changeMap(const AssetId &mapId) {
+	changeMap(MapLoader::getInstance()->getMap(mapId));
 }
 
 void World::changeMap(Map *newMap) {
 	map = newMap;
-	if (mapTexture != NULL) {
-		SDL_DestroyTexture(mapTexture);
-		mapTexture = NULL;
-	}
-	if (routeTextBox != NULL) {
-		WorldTextBox *txtBox = static_cast<WorldTextBox *> (routeTextBox);
-		txtBox->dismiss();
-		txtBox->setText(map->getMapName());
-		txtBox->show();
-		txtBox->dismissAfter(5000);
-	}
+	scripts->clear();
+	entities->setMap(map);
+	//The player lands on the new map, there's nothing to interpolate from the old one's coordinates
+	published = false;
+	markDirty();
+	showMessage(map->getMapName(), 5000);
+}
+
+void World::showMessage(const std::string &text, unsigned int ms) {
+	if (routeTextBox == NULL) return;
+	WorldTextBox *txtBox = static_cast<WorldTextBox *> (routeTextBox);
+	txtBox->dismiss();
+	txtBox->setText(text);
+	txtBox->show();
+	txtBox->dismissAfter(ms);
+}
+
+void World::markDirty() { dirty = true; }
+bool World::isDirty() const { 
+	//The camera follows the player, so every frame differs while anything is between two positions
+	const WorldSnapshot &snapshot = snapshots.getFront();
+	return redraw || snapshot.version != drawnVersion || snapshot.moving; 
+}
+void World::clearDirty() { 
+	redraw = false;
+	drawnVersion = snapshots.getFront().version;
 }
 
 /**
@@ -207,6 +283,8 @@ void World::changeMap(Map *newMap) {
  */
 Map * World::getMap() const { return map; }
 BaseWorldObject * World::getPlayer() const { return player; }
+WorldEntities * World::getEntities() const { return entities; }
+WorldScripts * World::getScripts() const { return scripts; }
 
 /**
 * Move listener for the player
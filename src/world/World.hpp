@@ -2,14 +2,26 @@
 #define WORLD_HPP
 
 #include "../map/Map.hpp"
+#include "../game/GameEvent.hpp"
+#include "../ecs/DrawListSystem.hpp"
+#include "../util/TripleBuffer.hpp"
+#include "WorldSnapshot.hpp"
 
 class Game;
 class Window;
 class Map;
 class BaseWorldObject;
-struct SDL_Texture;
+class TileScrollBuffer;
+class WorldEntities;
+class WorldScripts;
+class FontSprite;
 struct SDL_Rect;
 
+/**
+ * The world simulates on the simulation thread and is drawn on the main thread
+ * Nothing drawn is read from the simulation directly, every step is copied into a snapshot
+ * and render only ever uses the newest snapshot it acquired
+ */
 class World {
 public:
     World();
@@ -17,21 +29,57 @@ public:
 
 	void start(Game *game);
 	void stop(Game *game);
+
+	//Nothing ticks while paused, the snapshot stays put so the world can still be drawn under another screen
+	void pause(Game *game);
+	void resume(Game *game);
+	void handleEvent(const GameEvent &event);
+
+	//Simulation thread, copy the world as it is after this step
+	void publishSnapshot();
+
+	//Main thread
+	void acquireSnapshot();
     void render(Window *win);
 
 	BaseWorldObject * getPlayer() const;
+	WorldEntities * getEntities() const;
+	WorldScripts * getScripts() const;
     Map * getMap() const;
 
-    void changeMap(const char * const mapFile);
+    void changeMap(const AssetId &mapId);
 	void changeMap(Map *newMap);
 
+	//Show text in the text box for a while
+	void showMessage(const std::string &text, unsigned int ms);
+
+	//Damage tracking, world objects mark the world dirty when they change (simulation thread)
+	//and the frame is redrawn when the snapshot it was drawn from is out of date (main thread)
+	void markDirty();
+	bool isDirty() const;
+	void clearDirty();
+
 private:
+	//Simulation
     Map *map;
-    SDL_Texture *mapTexture;
 	BaseWorldObject *player, *routeTextBox;
+	WorldEntities *entities;
+	WorldScripts *scripts;
+	bool dirty, wasMoving, published;
+	unsigned int version;
+	int lastPlayerX, lastPlayerY;
+	TripleBuffer<WorldSnapshot> snapshots;
+
+	//Rendering
+	TileScrollBuffer *groundLayers, *overheadLayers;
+	DrawListSystem drawList;
+	FontSprite *routeText;
+	Font *routeTextFont;
+	unsigned int drawnVersion;
+	bool redraw;
 
-    void drawMap(Window *win);
-	void drawBorderingMap(Window *win, MapDirection direction, SDL_Rect mapSrc, SDL_Rect mapDst);
+    void drawMap(Window *win, const WorldSnapshot &snapshot);
+	void drawTextBox(Window *win, const WorldSnapshot &snapshot);
 };
 
 #endif
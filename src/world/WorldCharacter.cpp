@@ -1,10 +1,20 @@
 #include "WorldCharacter.hpp"
 #include "World.hpp"
+#include "WorldEntities.hpp"
 #include "../util/Utils.hpp"
 #include "../sprite/Sprites.hpp"
 #include "../map/Maps.hpp"
+#include "../util/ObjectPool.hpp"
 
-WorldCharacter::WorldCharacter(World *world, SpriteSheet *image, int movementUpdateTime, int movementSpeed)
+static ObjectPool<WorldCharacter> & getPool() {
+	static ObjectPool<WorldCharacter> pool(Constants::WORLD_CHARACTER_POOL_SIZE);
+	return pool;
+}
+
+void * WorldCharacter::operator new(size_t size) { return getPool().allocate(size); }
+void WorldCharacter::operator delete(void *memory) { getPool().free(memory); }
+
+WorldCharacter::WorldCharacter(World *world, const ResourceHandle<SpriteSheet> &image, int movementUpdateTime, int movementSpeed)
     : BaseWorldMover(world, image, movementUpdateTime, movementSpeed) {
     changeDirection(FacingDirection::DOWN);
     setWidth(Constants::CHARACTER_WIDTH);
@@ -19,6 +29,13 @@ WorldCharacter::~WorldCharacter() {
 	}
 }
 
+void WorldCharacter::onObjectTick(Game *game) {
+	BaseWorldMover::onObjectTick(game);
+
+	//Standing still, hold the tile it stands on (it may have been put somewhere else or the map changed)
+	if (!isMoving()) getWorld()->getEntities()->holdPlayerTiles(getTileX(), getTileY(), -1, -1);
+}
+
 void WorldCharacter::onTickInBackground() {}
 
 void WorldCharacter::setOnMoveListener(WorldCharacterMoveListener *listener) {
@@ -56,6 +73,18 @@ void WorldCharacter::onMoveStart(FacingDirection direction) {
         default:
             break;
     }
+
+    //Entities can't walk onto the tile it is leaving or the one it is walking onto
+    int targetX = getTileX(), targetY = getTileY();
+    switch(direction) {
+        case FacingDirection::LEFT: targetX--; break;
+        case FacingDirection::RIGHT: targetX++; break;
+        case FacingDirection::UP: targetY--; break;
+        case FacingDirection::DOWN: targetY++; break;
+        default: break;
+    }
+    if(checkForObstacles(targetX, targetY)) targetX = targetY = -1;
+    getWorld()->getEntities()->holdPlayerTiles(getTileX(), getTileY(), targetX, targetY);
 }
 
 void WorldCharacter::onMove(float percentToNextTile) {
@@ -77,6 +106,9 @@ void WorldCharacter::onMove(float percentToNextTile) {
 
 void WorldCharacter::onMoveEnd(FacingDirection direction) {
 	if (moveListener != NULL) moveListener->onMoveEnd(direction, getTileX(), getTileY());
+
+	//Only the tile it got to (or was moved to by a map change), turning back has to find the last one free
+	getWorld()->getEntities()->holdPlayerTiles(getTileX(), getTileY(), -1, -1);
 	SDL_Rect src = getSourceRect();
 	src.x = 0;
 	setSourceRect(src);
@@ -90,16 +122,10 @@ void WorldCharacter::onChangeDirection(FacingDirection direction) {
 }
 
 bool WorldCharacter::checkForObstacles(int tileX, int tileY) const {
-    //Check for walls in the tiles first
-    for(unsigned int i = 0; i < getWorld()->getMap()->getNumberOfLayers(); i++) {
-        Tile *tile = getWorld()->getMap()->getTile(i, tileX, tileY);
-        if(tile != NULL && 
-			tile->getTileType() != Constants::TILE_TYPE_FLOOR && 
-			tile->getTileType() != Constants::TILE_TYPE_FLOWER &&
-			tile->getTileType() != Constants::TILE_TYPE_GRASS) {
-            return true;
-        }
-    }
+    //Walking off the map goes to the next one
+    Map *map = getWorld()->getMap();
+    if(tileX < 0 || tileY < 0 || tileX >= map->getWidth() || tileY >= map->getHeight()) return false;
 
-    return false;
+    //The entities know the walls (same tile types as always) and who stands where, the player included
+    return !getWorld()->getEntities()->isWalkable(tileX, tileY);
 }
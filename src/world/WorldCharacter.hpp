@@ -1,6 +1,7 @@
 #ifndef WORLD_CHARACTER_HPP
 #define WORLD_CHARACTER_HPP
 
+#include <stddef.h>
 #include "BaseWorldMover.hpp"
 
 class Timer;
@@ -8,12 +9,20 @@ class WorldCharacterMoveListener;
 
 class WorldCharacter : public BaseWorldMover {
 public:
-    WorldCharacter(World *world, SpriteSheet *image, int movementUpdateTime, int movementSpeed);
+    WorldCharacter(World *world, const ResourceHandle<SpriteSheet> &image, int movementUpdateTime, int movementSpeed);
     ~WorldCharacter() override;
 
+	//Characters come out of a fixed size pool (Constants::WORLD_CHARACTER_POOL_SIZE)
+	static void * operator new(size_t size);
+	static void operator delete(void *memory);
+
 	void setOnMoveListener(WorldCharacterMoveListener *listener);
 
+	//True if a wall or an entity is on the tile and the character can't walk there, off the map is always free
+    bool checkForObstacles(int tileX, int tileY) const;
+
 protected:
+	void onObjectTick(Game *game) override;
 	void onTickInBackground() override;
 	void onMoveStart(FacingDirection direction) override;
 	void onMove(float percentToNextTile) override;
@@ -21,7 +30,6 @@ protected:
 	void onChangeDirection(FacingDirection direction) override;
 
 private:
-    bool checkForObstacles(int tileX, int tileY) const;
 	WorldCharacterMoveListener *moveListener;
 };
 
@@ -0,0 +1,126 @@
+#include "WorldEntities.hpp"
+
+#include "World.hpp"
+#include "WorldScripts.hpp"
+#include "../ecs/AnimationSystem.hpp"
+#include "../sprite/SpriteSheet.hpp"
+#include "../util/Constants.hpp"
+#include "../util/SystemTimings.hpp"
+
+WorldEntities::WorldEntities(World *w) : BaseGameObject(), world(w), map(NULL), moving(false), spritesVersion(0) {}
+
+WorldEntities::~WorldEntities() { registry.clear(); }
+
+Entity WorldEntities::spawnCharacter(const ResourceHandle<SpriteSheet> &image, int tileX, int tileY, FacingDirection facing) {
+	Entity entity = registry.create();
+	registry.transforms.add(entity, tileX, tileY, movement.getTileWidth(), movement.getTileHeight(), 0);
+	registry.movers.add(entity, Constants::CHARACTER_WALK_TIMER, Constants::CHARACTER_WALK_SPEED, facing);
+	registry.sprites.add(entity, image, Constants::CHARACTER_WIDTH, Constants::CHARACTER_HEIGHT, 
+		Constants::CHARACTER_TILE_OFFSET_Y);
+	registry.colliders.add(entity);
+	registry.animators.add(entity, Constants::CHARACTER_WIDTH, Constants::CHARACTER_HEIGHT);
+	movement.place(registry, entity);
+	movement.wake(registry, entity);
+	world->markDirty();
+	return entity;
+}
+
+void WorldEntities::destroy(const Entity &entity) {
+	if (!registry.isAlive(entity)) return;
+	world->getScripts()->stopEntity(entity);
+	movement.release(registry, entity);
+	registry.destroy(entity);
+	spritesVersion++;
+	world->markDirty();
+}
+
+void WorldEntities::setMap(Map *newMap) {
+	registry.clear();
+	map = newMap;
+	movement.setMap(map, registry);
+	moving = false;
+	spritesVersion++;
+}
+
+void WorldEntities::setTile(const Entity &entity, int tileX, int tileY) {
+	unsigned int transform = registry.transforms.indexOf(entity);
+	if (transform == ComponentPool::NO_COMPONENT) return;
+	movement.release(registry, entity);
+	TransformPool &transforms = registry.transforms;
+	transforms.tileX[transform] = tileX;
+	transforms.tileY[transform] = tileY;
+	transforms.posX[transform] = transforms.previousPosX[transform] = tileX * movement.getTileWidth();
+	transforms.posY[transform] = transforms.previousPosY[transform] = tileY * movement.getTileHeight();
+	transforms.drawX[transform] = transforms.posX[transform];
+	transforms.drawY[transform] = transforms.posY[transform];
+	unsigned int mover = registry.movers.indexOf(entity);
+	if (mover != ComponentPool::NO_COMPONENT) {
+		registry.movers.moving[mover] = false;
+		registry.movers.blocked[mover] = false;
+		registry.movers.displacement[mover] = 0;
+		registry.movers.direction[mover] = registry.movers.nextDirection[mover] = NONE;
+	}
+	movement.place(registry, entity);
+	movement.wake(registry, entity);
+	world->markDirty();
+}
+
+void WorldEntities::move(const Entity &entity, FacingDirection direction) {
+	unsigned int mover = registry.movers.indexOf(entity);
+	if (mover == ComponentPool::NO_COMPONENT || direction == NONE) return;
+	MoverPool &movers = registry.movers;
+	if (movers.moving[mover]) {
+		movers.nextDirection[mover] = direction;
+	}
+	else {
+		movers.direction[mover] = movers.facing[mover] = direction;
+		movers.moving[mover] = true;
+		movement.wake(registry, entity);
+	}
+}
+
+bool WorldEntities::isWalkable(int tileX, int tileY) const { return movement.isWalkable(tileX, tileY); }
+
+void WorldEntities::holdPlayerTiles(int tileX, int tileY, int targetX, int targetY) {
+	movement.hold(tileX, tileY, targetX, targetY);
+}
+
+bool WorldEntities::isMoving() const { return moving; }
+
+bool WorldEntities::capture(std::vector<SpriteState> &sprites, unsigned int &version) {
+	const std::vector<Entity> &updated = movement.getUpdated();
+	bool moved = DrawListSystem::capture(registry, updated, movement.getTileWidth(), movement.getTileHeight());
+	if (!updated.empty()) spritesVersion++;
+
+	//While anything changes the states are copied whole (one block), nothing is copied while everybody stands still
+	if (version != spritesVersion) {
+		sprites = registry.sprites.state;
+		version = spritesVersion;
+	}
+	return moved;
+}
+
+EntityRegistry * WorldEntities::getRegistry() { return &registry; }
+
+void WorldEntities::onGameTick(Game *) {
+	if (registry.size() == 0) return;
+	bool wasMoving = moving;
+	{
+		SystemTimer timer(SYSTEM_MOVEMENT);
+		moving = movement.update(registry, Constants::GAME_TICK_MICROSECONDS);
+	}
+	{
+		SystemTimer timer(SYSTEM_ANIMATION);
+		AnimationSystem::update(registry, movement.getUpdated(), movement.getTileWidth(), movement.getTileHeight());
+	}
+
+	//Wake the scripts waiting for these moves
+	{
+		SystemTimer timer(SYSTEM_SCRIPTS);
+		const std::vector<Entity> &moveEnds = movement.getMoveEnds();
+		for (unsigned int i = 0; i < moveEnds.size(); i++) world->getScripts()->onMoveEnd(moveEnds[i]);
+	}
+
+	//Coming to rest needs one more frame at the final positions
+	if (moving || wasMoving) world->markDirty();
+}
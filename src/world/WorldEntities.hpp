@@ -0,0 +1,67 @@
+#ifndef WORLD_ENTITIES_HPP
+#define WORLD_ENTITIES_HPP
+
+#include "../game/BaseGameObject.hpp"
+#include "../ecs/EntityRegistry.hpp"
+#include "../ecs/MovementSystem.hpp"
+#include "../ecs/DrawListSystem.hpp"
+
+class World;
+class Map;
+class SpriteSheet;
+
+/**
+ * Every entity on the current map (ie: NPCs), simulated a system at a time every step
+ * instead of as one game object each
+ * The systems only look at the entities that are awake (walking, or just made or moved),
+ * entities standing around cost nothing per step, see MovementSystem
+ */
+class WorldEntities : public BaseGameObject {
+public:
+	WorldEntities(World *world);
+	~WorldEntities() override;
+
+	//Add a character that looks and walks like the player
+	Entity spawnCharacter(const ResourceHandle<SpriteSheet> &image, int tileX, int tileY, FacingDirection facing);
+	void destroy(const Entity &entity);
+
+	//Entities belong to the map they are on, changing maps removes all of them
+	void setMap(Map *map);
+
+	//Teleport an entity to a tile, it stops walking
+	void setTile(const Entity &entity, int tileX, int tileY);
+
+	//Walk one tile, queued up if the entity is already walking
+	void move(const Entity &entity, FacingDirection direction);
+
+	//Inside the map, not a wall and no entity (or the player) standing there
+	bool isWalkable(int tileX, int tileY) const;
+
+	//The player's tile and the one it walks onto (outside the map for none), entities walk around them
+	//Changing maps gives them back, the player takes its tile again on its next tick
+	void holdPlayerTiles(int tileX, int tileY, int targetX, int targetY);
+
+	//Anything walking or still being drawn on its way to a tile
+	bool isMoving() const;
+
+	//Capture the sprites that changed this step, true if any of them moved since their last capture
+	//sprites is only copied over (whole) when it is older than version says, version is updated
+	bool capture(std::vector<SpriteState> &sprites, unsigned int &version);
+
+	EntityRegistry * getRegistry();
+
+protected:
+	void onGameTick(Game *game) override;
+
+private:
+	World *world;
+	Map *map;
+	EntityRegistry registry;
+	MovementSystem movement;
+	bool moving;
+
+	//Goes up whenever a sprite state changes or an entity goes away
+	unsigned int spritesVersion;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "WorldNpc.hpp"
+
+#include "WorldEntities.hpp"
+
+WorldNpc::WorldNpc(WorldEntities *e, const Entity &id) : entities(e), entity(id) {}
+
+bool WorldNpc::exists() const { return entities != NULL && entities->getRegistry()->isAlive(entity); }
+Entity WorldNpc::getEntity() const { return entity; }
+
+void WorldNpc::move(FacingDirection direction) { entities->move(entity, direction); }
+void WorldNpc::cancelNextMove() {
+	unsigned int index = mover();
+	if (index != ComponentPool::NO_COMPONENT) entities->getRegistry()->movers.nextDirection[index] = NONE;
+}
+void WorldNpc::setTile(int tileX, int tileY) { entities->setTile(entity, tileX, tileY); }
+
+bool WorldNpc::isMoving() const {
+	unsigned int index = mover();
+	return index != ComponentPool::NO_COMPONENT && entities->getRegistry()->movers.moving[index];
+}
+FacingDirection WorldNpc::getCurrentDirection() const {
+	unsigned int index = mover();
+	if (index == ComponentPool::NO_COMPONENT) return NONE;
+	return static_cast<FacingDirection> (entities->getRegistry()->movers.direction[index]);
+}
+FacingDirection WorldNpc::getFacingDirection() const {
+	unsigned int index = mover();
+	if (index == ComponentPool::NO_COMPONENT) return NONE;
+	return static_cast<FacingDirection> (entities->getRegistry()->movers.facing[index]);
+}
+int WorldNpc::getTileX() const { 
+	unsigned int index = transform();
+	return index == ComponentPool::NO_COMPONENT ? 0 : entities->getRegistry()->transforms.tileX[index];
+}
+int WorldNpc::getTileY() const { 
+	unsigned int index = transform();
+	return index == ComponentPool::NO_COMPONENT ? 0 : entities->getRegistry()->transforms.tileY[index];
+}
+int WorldNpc::getPositionX() const { 
+	unsigned int index = transform();
+	return index == ComponentPool::NO_COMPONENT ? 0 : entities->getRegistry()->transforms.posX[index];
+}
+int WorldNpc::getPositionY() const { 
+	unsigned int index = transform();
+	return index == ComponentPool::NO_COMPONENT ? 0 : entities->getRegistry()->transforms.posY[index];
+}
+int WorldNpc::getLayer() const { 
+	unsigned int index = transform();
+	return index == ComponentPool::NO_COMPONENT ? 0 : entities->getRegistry()->transforms.layer[index];
+}
+
+unsigned int WorldNpc::transform() const { return entities->getRegistry()->transforms.indexOf(entity); }
+unsigned int WorldNpc::mover() const { return entities->getRegistry()->movers.indexOf(entity); }
@@ -0,0 +1,41 @@
+#ifndef WORLD_NPC_HPP
+#define WORLD_NPC_HPP
+
+#include "FacingDirection.hpp"
+#include "../ecs/Entity.hpp"
+
+class WorldEntities;
+
+/**
+ * Object style access to a character entity, it only holds the entity's id
+ * Copy it around freely, it stops existing once the entity is destroyed
+ */
+class WorldNpc {
+public:
+	WorldNpc(WorldEntities *entities, const Entity &entity);
+
+	bool exists() const;
+	Entity getEntity() const;
+
+	void move(FacingDirection direction);
+	void cancelNextMove();
+	void setTile(int tileX, int tileY);
+
+	bool isMoving() const;
+	FacingDirection getCurrentDirection() const;
+	FacingDirection getFacingDirection() const;
+	int getTileX() const;
+	int getTileY() const;
+	int getPositionX() const;
+	int getPositionY() const;
+	int getLayer() const;
+
+private:
+	WorldEntities *entities;
+	Entity entity;
+
+	unsigned int transform() const;
+	unsigned int mover() const;
+};
+
+#endif
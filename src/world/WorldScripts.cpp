@@ -0,0 +1,194 @@
+#include "WorldScripts.hpp"
+
+#include <cstdlib>
+#include "World.hpp"
+#include "WorldEntities.hpp"
+#include "WorldNpc.hpp"
+#include "../util/Constants.hpp"
+
+WorldScripts::WorldScripts(World *w, WorldEntities *e) : world(w), entities(e), timers(NULL), pausedUs(0) {}
+
+WorldScripts::~WorldScripts() { clear(); }
+
+void WorldScripts::start(TimerWheel *wheel) { timers = wheel; }
+
+ScriptId WorldScripts::define(const Script &script) {
+	scripts.push_back(script);
+	return static_cast<ScriptId> (scripts.size() - 1);
+}
+
+ScriptHandle WorldScripts::run(const Entity &entity, ScriptId script) {
+	if (timers == NULL || script >= scripts.size() || !entities->getRegistry()->isAlive(entity)) return INVALID_SLOT_HANDLE;
+	stopEntity(entity);
+	ScriptTask task;
+	task.entity = entity;
+	task.script = script;
+	task.step = 0;
+	task.timer = INVALID_SLOT_HANDLE;
+	task.wakeUs = 0;
+	task.sleepingWhenPaused = false;
+	task.waitingForMove = false;
+	task.walking = false;
+	task.lastTileX = task.lastTileY = 0;
+	task.lastDirection = NONE;
+	ScriptHandle handle = tasks.insert(task);
+	if (byEntity.size() <= entity.index) byEntity.resize(entity.index + 1, INVALID_SLOT_HANDLE);
+	byEntity[entity.index] = handle;
+	resume(handle);
+	return handle;
+}
+
+void WorldScripts::stop(const ScriptHandle &handle) {
+	ScriptTask *task = tasks.get(handle);
+	if (task == NULL) return;
+	if (timers != NULL) timers->cancel(task->timer);
+	if (task->entity.index < byEntity.size() && byEntity[task->entity.index] == handle) {
+		byEntity[task->entity.index] = INVALID_SLOT_HANDLE;
+	}
+	tasks.remove(handle);
+}
+
+void WorldScripts::stopEntity(const Entity &entity) {
+	if (entity.index >= byEntity.size()) return;
+	ScriptHandle handle = byEntity[entity.index];
+	ScriptTask *task = tasks.get(handle);
+	if (task != NULL && task->entity == entity) stop(handle);
+}
+
+bool WorldScripts::isRunning(const ScriptHandle &handle) const { return tasks.contains(handle); }
+
+void WorldScripts::clear() {
+	for (unsigned int i = 0; timers != NULL && i < tasks.size(); i++) timers->cancel(tasks[i].timer);
+	tasks.clear();
+	byEntity.clear();
+}
+
+void WorldScripts::pauseAll() {
+	if (timers == NULL) return;
+	pausedUs = timers->getTimeMicroseconds();
+	for (unsigned int i = 0; i < tasks.size(); i++) {
+		tasks[i].sleepingWhenPaused = timers->cancel(tasks[i].timer);
+		tasks[i].timer = INVALID_SLOT_HANDLE;
+	}
+}
+
+void WorldScripts::resumeAll() {
+	if (timers == NULL) return;
+	for (unsigned int i = 0; i < tasks.size(); i++) {
+		ScriptTask &task = tasks[i];
+		if (!task.sleepingWhenPaused) continue;
+		task.sleepingWhenPaused = false;
+		sleep(task, tasks.getHandle(i), task.wakeUs > pausedUs ? static_cast<unsigned int> (task.wakeUs - pausedUs) : 0);
+	}
+}
+
+void WorldScripts::onMoveEnd(const Entity &entity) {
+	if (entity.index >= byEntity.size()) return;
+	ScriptHandle handle = byEntity[entity.index];
+	ScriptTask *task = tasks.get(handle);
+	if (task == NULL || !task->waitingForMove || task->entity != entity) return;
+	task->waitingForMove = false;
+	resume(handle);
+}
+
+unsigned int WorldScripts::size() const { return tasks.size(); }
+
+void WorldScripts::resume(const ScriptHandle &handle) {
+	//A script that gets through every step without waiting on anything is put to sleep until the next step
+	unsigned int stepsRun = 0;
+	while (true) {
+		ScriptTask *task = tasks.get(handle);
+		if (task == NULL) return;
+		if (!entities->getRegistry()->isAlive(task->entity)) {
+			stop(handle);
+			return;
+		}
+		const Script &script = scripts[task->script];
+		if (task->step >= script.getSteps().size()) {
+			if (!script.isLooping() || script.getSteps().empty()) {
+				stop(handle);
+				return;
+			}
+			task->step = 0;
+		}
+		if (stepsRun++ > script.getSteps().size()) {
+			sleep(*task, handle, 0);
+			return;
+		}
+
+		const ScriptStep &step = script.getSteps()[task->step];
+		switch (step.type) {
+			case SCRIPT_WALK_TO:
+				if (walk(*task, handle, step.tileX, step.tileY)) return;
+				task->step++;
+				break;
+			case SCRIPT_WAIT:
+				task->step++;
+				sleep(*task, handle, step.ms * 1000);
+				return;
+			case SCRIPT_SHOW_TEXT:
+				task->step++;
+				world->showMessage(step.text, step.ms);
+				sleep(*task, handle, step.ms * 1000);
+				return;
+			case SCRIPT_WAIT_FOR_MOVE_END:
+				task->step++;
+				task->waitingForMove = true;
+				return;
+			case SCRIPT_CALL: {
+				//The function can stop this script or define more, neither the task nor the step are safe to use after
+				task->step++;
+				ScriptFunction function = step.function;
+				WorldNpc npc(entities, task->entity);
+				function(npc);
+				break;
+			}
+		}
+	}
+}
+
+void WorldScripts::sleep(ScriptTask &task, const ScriptHandle &handle, unsigned int delayUs) {
+	task.wakeUs = timers->getTimeMicroseconds() + delayUs;
+	task.timer = timers->schedule(delayUs, [this, handle]() {
+		ScriptTask *sleeping = tasks.get(handle);
+		if (sleeping == NULL) return;
+		sleeping->timer = INVALID_SLOT_HANDLE;
+		resume(handle);
+	});
+}
+
+bool WorldScripts::walk(ScriptTask &task, const ScriptHandle &handle, int tileX, int tileY) {
+	WorldNpc npc(entities, task.entity);
+	int dx = tileX - npc.getTileX(), dy = tileY - npc.getTileY();
+	if (dx == 0 && dy == 0) {
+		task.walking = false;
+		return false;
+	}
+
+	//Along the longest way first, if that is blocked go the other way (or step aside when already lined up),
+	//if that is blocked too wait a bit
+	FacingDirection across = dx == 0 ? NONE : (dx > 0 ? RIGHT : LEFT);
+	FacingDirection down = dy == 0 ? NONE : (dy > 0 ? DOWN : UP);
+	FacingDirection first = std::abs(dx) >= std::abs(dy) ? across : down;
+	FacingDirection second = first == across ? down : across;
+	if (second == NONE) second = first == across ? DOWN : RIGHT;
+	FacingDirection direction = first;
+	bool blocked = task.walking && npc.getTileX() == task.lastTileX && npc.getTileY() == task.lastTileY;
+	if (blocked) {
+		if (task.lastDirection == first) {
+			direction = second;
+		}
+		else {
+			task.walking = false;
+			sleep(task, handle, Constants::WORLD_SCRIPT_BLOCKED_RETRY_TIME * 1000);
+			return true;
+		}
+	}
+	task.walking = true;
+	task.lastTileX = npc.getTileX();
+	task.lastTileY = npc.getTileY();
+	task.lastDirection = direction;
+	task.waitingForMove = true;
+	npc.move(direction);
+	return true;
+}
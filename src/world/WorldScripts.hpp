@@ -0,0 +1,87 @@
+#ifndef WORLD_SCRIPTS_HPP
+#define WORLD_SCRIPTS_HPP
+
+#include <vector>
+#include "Script.hpp"
+#include "FacingDirection.hpp"
+#include "../ecs/Entity.hpp"
+#include "../util/SlotMap.hpp"
+#include "../util/TimerWheel.hpp"
+
+class World;
+class WorldEntities;
+
+typedef unsigned int ScriptId;
+typedef SlotHandle ScriptHandle;
+
+/**
+ * Runs scripts on world entities
+ * A running script only does anything when what it is waiting for happens:
+ * timers go off through the timer wheel and finished moves come from the movement system,
+ * both wake the one script waiting on them, sleeping scripts cost nothing per step
+ * The NPC itself only costs something while it walks: the systems skip entities standing still (see MovementSystem),
+ * what still grows with every NPC is the renderer culling the whole sprite list and copying it while any of them walk
+ * Running scripts are kept packed in a slot map, starting and stopping them reuses the same storage
+ */
+class WorldScripts {
+public:
+	WorldScripts(World *world, WorldEntities *entities);
+	~WorldScripts();
+
+	//Timers go off on this wheel, scripts can't run before
+	void start(TimerWheel *timers);
+
+	//Keep a script to run, every entity running it shares the same copy
+	ScriptId define(const Script &script);
+
+	//Run a script on an entity from the first step, it stops whatever the entity was running
+	ScriptHandle run(const Entity &entity, ScriptId script);
+
+	void stop(const ScriptHandle &handle);
+	void stopEntity(const Entity &entity);
+	bool isRunning(const ScriptHandle &handle) const;
+
+	//Stop every script (changing maps removes every entity)
+	void clear();
+
+	//While the world is paused, sleeping scripts keep however long they had left to sleep
+	void pauseAll();
+	void resumeAll();
+
+	//The movement system finished moving the entity
+	void onMoveEnd(const Entity &entity);
+
+	unsigned int size() const;
+
+private:
+	typedef struct ScriptTask {
+		Entity entity;
+		ScriptId script;
+		unsigned int step;
+		TimerHandle timer;
+		unsigned long long wakeUs;
+		bool sleepingWhenPaused;
+		bool waitingForMove;
+
+		//Walking, where the last move started from and which way, to tell when it bumped into something
+		bool walking;
+		int lastTileX, lastTileY;
+		FacingDirection lastDirection;
+	} ScriptTask;
+
+	World *world;
+	WorldEntities *entities;
+	TimerWheel *timers;
+	unsigned long long pausedUs;
+	std::vector<Script> scripts;
+	SlotMap<ScriptTask> tasks;
+
+	//The script running on every entity, by entity index
+	std::vector<ScriptHandle> byEntity;
+
+	void resume(const ScriptHandle &handle);
+	void sleep(ScriptTask &task, const ScriptHandle &handle, unsigned int delayUs);
+	bool walk(ScriptTask &task, const ScriptHandle &handle, int tileX, int tileY);
+};
+
+#endif
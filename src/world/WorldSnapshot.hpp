@@ -0,0 +1,44 @@
+#ifndef WORLD_SNAPSHOT_HPP
+#define WORLD_SNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL_rect.h>
+#include "../ecs/DrawListSystem.hpp"
+
+class Map;
+class Font;
+struct SDL_Texture;
+
+/**
+ * Everything the world draws, copied after a simulation step
+ * Positions are kept for the step before as well, frames are drawn in between the two
+ */
+typedef struct WorldSnapshot {
+	Map *map;
+
+	//Goes up whenever the world changed, the frame only needs drawing again when it differs from the last one drawn
+	unsigned int version;
+
+	//Something is drawn in a different place than at the step before
+	bool moving;
+
+	//The player, the camera follows it
+	int playerPreviousX, playerPreviousY, playerX, playerY, playerLayer;
+	SDL_Texture *playerTexture;
+	SDL_Rect playerSrc;
+	int playerWidth, playerHeight;
+
+	//Map name box, in window coordinates
+	bool textBoxShown;
+	SDL_Texture *textBoxTexture;
+	SDL_Rect textBoxSrc, textBoxDst;
+	std::string textBoxText;
+	Font *textBoxFont;
+
+	//Every entity sprite, not culled or sorted yet, only copied again when entitiesVersion is out of date
+	std::vector<SpriteState> entities;
+	unsigned int entitiesVersion;
+} WorldSnapshot;
+
+#endif
@@ -4,50 +4,36 @@
 #include "../game/Game.hpp"
 #include "../sprite/Sprites.hpp"
 #include "../util/Utils.hpp"
+#include "../util/ObjectPool.hpp"
 
-WorldTextBox::WorldTextBox(World *w, SpriteSheet *image, Font *font, bool isDialogue) : 
+static ObjectPool<WorldTextBox> & getPool() {
+	static ObjectPool<WorldTextBox> pool(Constants::WORLD_TEXT_BOX_POOL_SIZE);
+	return pool;
+}
+
+void * WorldTextBox::operator new(size_t size) { return getPool().allocate(size); }
+void WorldTextBox::operator delete(void *memory) { getPool().free(memory); }
+
+WorldTextBox::WorldTextBox(World *w, const ResourceHandle<SpriteSheet> &image, const ResourceHandle<Font> &font, bool isDialogue) : 
 	  BaseWorldObject(w, image, Constants::WORLD_MAP_NAME_ANIM_TICK_TIME),
 	  dialogue(isDialogue), 
 	  animIn(false),
-	  changedText(false),
-	  changedFont(true),
 	  drawBox(false),
 	  message(""),
-	  dismissTimer(NULL),
-	  messageFont(font),
-	  messageSprite(NULL) {
+	  dismissCall(INVALID_SLOT_HANDLE),
+	  messageFont(font) {
 	int width, height;
 	getImageDimensions(width, height);
 	setSourceRect(Util::createRect(0, 0, width, height));
 	setDestinationRect(Util::createRect(0, -height, width * 5, height * 2));
 }
 
-WorldTextBox::~WorldTextBox() { 
-	messageFont = NULL;
-	if (dismissTimer != NULL) {
-		delete dismissTimer;
-		dismissTimer = NULL;
-	}
-	if (messageSprite != NULL) {
-		delete messageSprite;
-		messageSprite = NULL;
-	}
-}
+WorldTextBox::~WorldTextBox() { cancelCall(dismissCall); }
 
 void WorldTextBox::onObjectTick(Game *) {
-	if (dismissTimer != NULL && dismissTimer->check()) {
-		dismiss();
-	}
-	else if(drawBox && animIn) {
+	if(drawBox && animIn) {
 		if (getRawY() < 0) {
 			setRawY(getRawY() + 4);
-			if (messageSprite != NULL) {
-				SDL_Rect textRect = Util::createRect(getRawX() + getWidth() / 4,
-					getRawY() + getHeight() / 4,
-					getWidth() / 2, 
-					getHeight() / 2);
-				messageSprite->getSprite()->setDstRect(textRect);
-			}
 		}
 		else {
 			animIn = false;
@@ -57,47 +43,38 @@ void WorldTextBox::onObjectTick(Game *) {
 
 void WorldTextBox::onTickInBackground() {}
 
-void WorldTextBox::setText(const std::string &text) { message = text; changedText = true; }
+void WorldTextBox::setText(const std::string &text) { message = text; markDirty(); }
 
-void WorldTextBox::setFont(Font *font) { messageFont = font; changedFont = true; }
+void WorldTextBox::setFont(const ResourceHandle<Font> &font) { messageFont = font; markDirty(); }
 
 void WorldTextBox::show() {
 	if (drawBox) return;
 	drawBox = true;
+	markDirty();
 	if (!dialogue) animIn = true;
 }
 
 void WorldTextBox::dismiss() {
 	if (!drawBox) return;
 	drawBox = false;
+	markDirty();
 	setRawY(-getHeight());
 }
 
 void WorldTextBox::dismissAfter(unsigned int ms) {
-	if (dismissTimer != NULL) delete dismissTimer;
-	dismissTimer = new Timer(ms);
+	cancelCall(dismissCall);
+	dismissCall = callAfter(ms, [this]() {
+		dismissCall = INVALID_SLOT_HANDLE;
+		dismiss();
+	});
 }
 
 void WorldTextBox::nextLine() {}
 
-void WorldTextBox::onDraw(Window *win) {
-	if (changedText) {
-		if (messageSprite != NULL) messageSprite->setText(win, message);
-		changedText = false;
-	}
-	if (changedFont) {
-		if (messageSprite != NULL) delete messageSprite;
-		messageSprite = messageFont->createFontSprite(win, message);
-		changedFont = false;
-	}
-	if (drawBox) {
-		//TODO: draw the box
-		if (dialogue) {
+bool WorldTextBox::isShown() const { return drawBox; }
 
-		}
-		else {
-			BaseWorldObject::onDraw(win);
-			messageSprite->draw(win);
-		}
-	}
-}
\ No newline at end of file
+bool WorldTextBox::isDialogue() const { return dialogue; }
+
+const std::string & WorldTextBox::getText() const { return message; }
+
+Font * WorldTextBox::getFont() const { return messageFont.get(); }
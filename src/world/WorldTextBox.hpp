@@ -2,36 +2,43 @@
 #define WORLD_TEXT_BOX_HPP
 
 #include "BaseWorldObject.hpp"
+#include <stddef.h>
 #include <string>
 
 class SpriteSheet;
-class Sprite;
-class FontSprite;
 class Font;
 
 class WorldTextBox : public BaseWorldObject {
 public:
-	WorldTextBox(World *w, SpriteSheet *image, Font *fontFile, bool isDialogue);
+	WorldTextBox(World *w, const ResourceHandle<SpriteSheet> &image, const ResourceHandle<Font> &fontFile, bool isDialogue);
 	~WorldTextBox() override;
 
+	//Text boxes come out of a fixed size pool (Constants::WORLD_TEXT_BOX_POOL_SIZE)
+	static void * operator new(size_t size);
+	static void operator delete(void *memory);
+
 	void show();
 	void dismiss();
 	void dismissAfter(unsigned int ms);
 	void nextLine();
-	void setFont(Font *font);
+	void setFont(const ResourceHandle<Font> &font);
 	void setText(const std::string &text);
 
+	//The world draws the box and its text from these
+	bool isShown() const;
+	bool isDialogue() const;
+	const std::string & getText() const;
+	Font * getFont() const;
+
 protected:
 	void onObjectTick(Game *game) override;
 	void onTickInBackground() override;
-	void onDraw(Window *win) override;
 
 private:
-	bool dialogue, animIn, changedText, changedFont, drawBox;
+	bool dialogue, animIn, drawBox;
 	std::string message;
-	Timer *dismissTimer;
-	Font *messageFont;
-	FontSprite *messageSprite;
+	TimerHandle dismissCall;
+	ResourceHandle<Font> messageFont;
 };
 
 #endif
\ No newline at end of file